@@ -1,7 +1,7 @@
 /*
  * 彩色ASCII视频转换器
  * 将普通视频转换为ASCII字符艺术风格的彩色视频
- * 编译命令：g++ -O3 -march=native -std=c++17 -o miku miku.cpp `pkg-config --cflags --libs opencv4` -lpthread
+ * 编译命令：g++ -O3 -march=native -std=c++20 -o miku miku.cpp `pkg-config --cflags --libs opencv4` -lz -lpthread
  * 使用示例：./miku input.mp4 output.mp4 80
  *
  * 作者: miku-01-hein + GPT
@@ -21,6 +21,60 @@
 #include <algorithm>             // 算法函数（如min、max、clamp等）
 #include <cmath>                 // 数学函数
 #include <iomanip>               // 输出格式化
+#include <thread>                // 线程（拼接模式的解码线程）
+#include <mutex>                 // 互斥锁
+#include <condition_variable>    // 条件变量（解码队列同步）
+#include <deque>                 // 双端队列（解码帧队列）
+#include <memory>                // 智能指针
+#include <cstdint>               // 定宽整数类型
+#include <cstring>               // 内存拷贝
+#include <fstream>               // 文件读写（字形图集缓存）
+#include <sstream>               // 字符串流（网格文件头编码）
+#include <cstdlib>               // 环境变量、mkstemp
+#include <cstdio>                // rename（原子替换缓存文件）
+#include <sys/stat.h>            // 文件修改时间、创建缓存目录
+#include <atomic>                // 原子计数（并发任务调度）
+#include <functional>            // 函数对象（I/O任务队列）
+#include <optional>              // 可选值（任务队列取值）
+#include <cerrno>                // 系统调用错误码
+#include <fcntl.h>               // 打开输出文件
+#include <unistd.h>              // pwrite、close
+
+// io_uring异步写出（可选）：编译时定义MIKU_WITH_URING并链接liburing后，
+// 图像序列和字符网格文件的写操作经io_uring整批提交，否则由写出线程逐个pwrite
+#if defined(MIKU_WITH_URING) && __has_include(<liburing.h>)
+#include <liburing.h>
+#define MIKU_HAS_URING
+#endif
+
+// C++20协程：可用时并发任务在事件循环上交错执行，否则每个任务使用一个线程
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+#include <coroutine>
+#define MIKU_HAS_COROUTINES
+#endif
+
+// FreeType字体渲染（可选）：编译时定义MIKU_WITH_FREETYPE并链接freetype2后可用 --font
+#ifdef MIKU_WITH_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_OUTLINE_H
+#endif
+
+// 动画WebP输出（可选）：编译时定义MIKU_WITH_WEBP并链接libwebp、libwebpmux后可输出.webp
+#if defined(MIKU_WITH_WEBP) && __has_include(<webp/mux.h>)
+#include <webp/encode.h>
+#include <webp/mux.h>
+#define MIKU_HAS_WEBP
+#endif
+
+#include "miku_grid.h"          // 结构数组字符网格和网格文件格式
+
+// 内嵌的默认字形图集（由 ./miku --dump-glyph-header miku_glyphs.h 生成），
+// 缺少该文件时启动时用putText绘制
+#if __has_include("miku_glyphs.h")
+#include "miku_glyphs.h"
+#define MIKU_HAS_EMBEDDED_GLYPHS
+#endif
 
 /*
  * ASCII视频转换器命名空间
@@ -53,6 +107,10 @@ namespace ASCIIVideoConstants {
     // 较小的字体大小可以使字符更加紧凑
     constexpr double ASCII_FONT_SIZE = 0.3;
 
+    // 字形图集左右两侧的留白（像素）
+    // 个别字符（如m、W、@）在0.3字号下比字符格宽1-2像素，留白保证图集与putText绘制结果一致
+    constexpr int ATLAS_GLYPH_PADDING = 2;
+
     // 亮度权重常量：用于将RGB颜色转换为亮度（灰度）值
     // 这些权重基于人眼对不同颜色的敏感度
     // 红色权重：0.299，人眼对红色最敏感
@@ -61,307 +119,4840 @@ namespace ASCIIVideoConstants {
     constexpr double GREEN_WEIGHT = 0.587;
     // 蓝色权重：0.114，人眼对蓝色最不敏感
     constexpr double BLUE_WEIGHT = 0.114;
+
+    // 亮度权重的8位定点形式（乘以256后取整，三者之和为256），用于逐字符格的整数亮度计算
+    constexpr int RED_WEIGHT_Q8 = static_cast<int>(RED_WEIGHT * 256 + 0.5);
+    constexpr int GREEN_WEIGHT_Q8 = static_cast<int>(GREEN_WEIGHT * 256 + 0.5);
+    constexpr int BLUE_WEIGHT_Q8 = 256 - RED_WEIGHT_Q8 - GREEN_WEIGHT_Q8;
+
+    // 拼接模式每个输入解码队列的最大帧数
+    // 队列满时解码线程等待，避免快的输入无限占用内存
+    constexpr int MOSAIC_QUEUE_CAPACITY = 8;
+
+    // 拼接模式最多支持的输入数量
+    constexpr int MAX_MOSAIC_INPUTS = 16;
+
+    // 黑边检测阈值：整行（列）平均亮度低于此值视为黑边（0-255）
+    constexpr int AUTOCROP_BLACK_THRESHOLD = 24;
+
+    // 黑边检测采样帧数：启动时和每次场景切换后各采样这么多帧
+    constexpr int AUTOCROP_SAMPLE_FRAMES = 5;
+
+    // 场景切换阈值：相邻两帧ASCII网格的平均像素差超过此值视为切换镜头
+    constexpr double SCENE_CUT_THRESHOLD = 40.0;
+
+    // 超采样时每个字符格每个方向的最大采样数
+    constexpr int MAX_SUPERSAMPLE = 4;
+
+    // 线性光分析的精度：sRGB字节转换为12位整数线性光值（0-4095）
+    // 12位既能保留暗部精度，又能保证16位累加与INTER_AREA插值不溢出
+    constexpr int LINEAR_LIGHT_LEVELS = 4096;
+
+    // 自动色阶：亮度直方图中裁掉的暗部和亮部比例
+    constexpr double AUTOLEVELS_CLIP_FRACTION = 0.01;
+
+    // 自动色阶：拉伸后的亮度范围下限，避免近乎纯色的画面把噪声放大成满屏字符
+    constexpr int AUTOLEVELS_MIN_RANGE = 48;
+
+    // 自动色阶：时间平滑系数（0-1），越小色阶随画面变化越慢，1表示逐帧独立
+    constexpr double AUTOLEVELS_SMOOTHING = 0.15;
+
+    // 字符集最多包含的字形数（亮度到字形的查找表使用8位字形编号）
+    constexpr int MAX_CHARSET_GLYPHS = 256;
+
+    // 并发任务调度：阻塞I/O线程数上限（每个任务同一时刻最多占用一个）
+    constexpr int MAX_JOB_IO_THREADS = 8;
+
+    // 输入预读：默认预读窗口（MB）、窗口上限（MB）和每次预读的块大小（字节）
+    constexpr int READAHEAD_DEFAULT_MB = 64;
+    constexpr int MAX_READAHEAD_MB = 4096;
+    constexpr int READAHEAD_CHUNK_BYTES = 4 << 20;
+
+    // 异步写出：缓冲池中的缓冲区数，即同时在途的写请求数上限（也是io_uring队列深度）
+    constexpr int OUTPUT_BUFFER_COUNT = 16;
+
+    // 分段输出：同时编码的分段数上限，以及所有分段帧队列共用的内存预算（MB）
+    constexpr int MAX_SEGMENT_ENCODERS = 4;
+    constexpr int SEGMENT_BUFFER_MB = 256;
+
+    // 分段时长范围（秒）
+    constexpr double MIN_SEGMENT_SECONDS = 0.5;
+    constexpr double MAX_SEGMENT_SECONDS = 60.0;
+
+    // GIF输出的最高帧率：多数播放器把小于2厘秒的帧间隔当作10厘秒，超过时按整数间隔抽帧
+    constexpr double GIF_MAX_FPS = 50.0;
+
+    // 动画WebP无损编码的压缩方法（0-6，越大越慢）和压缩力度（0-100）
+    constexpr int WEBP_METHOD = 1;
+    constexpr float WEBP_EFFORT = 25.0f;
+
+    // 编码器基准测试最多渲染到内存中的帧数
+    constexpr int MAX_BENCH_FRAMES = 2000;
+
+    // 字符网格文件的关键帧间隔（帧数）：其余帧写成只含变化字符格的预测帧
+    constexpr int GRID_KEYFRAME_INTERVAL = 250;
+
+    // 批量分析的最大批大小（帧数）
+    constexpr int MAX_BATCH_FRAMES = 32;
+
+    // 隔行更新的最大行间隔
+    constexpr int MAX_INTERLACE = 8;
+
+    // 覆盖率补偿：颜色增益上限，避免笔画很细的字符（如'.'）被放大到过曝
+    constexpr double COVERAGE_MAX_GAIN = 4.0;
+
+    // 字形图集缓存文件的格式标识和版本，格式变化时增加版本号使旧缓存失效
+    constexpr uint32_t ATLAS_CACHE_MAGIC = 0x5441474D;  // "MGAT"
+    constexpr uint32_t ATLAS_CACHE_VERSION = 2;
+
+    // FreeType字体加粗强度（26.6定点像素，64为1像素）
+    constexpr int FONT_EMBOLDEN_STRENGTH = 40;
+
+    // 背景填充模式：对比色字符相对背景的变暗/提亮比例（0-255，按255为1）
+    constexpr int BACKGROUND_GLYPH_CONTRAST = 160;
+
+    // Lab查找表的网格：每个通道33个节点（步长8），节点之间三线性插值
+    constexpr int LAB_GRID_NODES = 33;
+
+    // Lab值的定点精度：L*、a*、b*均乘以16后以整数存储
+    constexpr int LAB_FIXED_SCALE = 16;
+
+    // 兴趣区域模式下外围字符格的放大倍数
+    // 外围每个字符占据 2x2 个普通字符格，只需一次平均和一次绘制
+    constexpr int ROI_COARSE_FACTOR = 2;
 }
 
 /*
- * EnhancedASCIIConverter类
- * 主转换器类，负责将视频转换为ASCII艺术风格
- * 使用RAII（资源获取即初始化）原则管理资源
+ * 转换选项结构体
+ * 汇总命令行中的可选功能开关，由main解析后传给转换器
  */
-class EnhancedASCIIConverter {
-private:
-    // 当前使用的字符集字符串
-    std::string currentCharset;
+struct ConversionOptions {
+    // 自动检测并裁剪上下（左右）黑边，让整个ASCII网格都用于画面内容
+    bool autoCrop = false;
 
-    // 已处理的帧计数器
-    int frameCount;
+    // 手动裁剪区域（原始视频像素坐标），面积为0表示不裁剪；指定后不再自动检测黑边
+    cv::Rect crop;
+
+    // 兴趣区域（原始视频像素坐标）：区域内使用正常密度网格，区域外使用更大的字符格
+    bool roiEnabled = false;
+    bool roiCenter = false;  // 使用画面中央一半宽高的区域作为兴趣区域
+    cv::Rect roi;
+
+    // 使用积分图分析路径代替cv::resize求每个字符格的平均颜色
+    bool summedAreaAnalysis = false;
+
+    // 超采样：每个字符格取 N x N 个采样点，在字符生成循环中求平均（1表示不超采样）
+    int supersample = 1;  // 只在 --sat 积分图路径上生效
+
+    // 伽马正确缩放：在线性光空间求平均，避免高反差细节变暗
+    bool linearLight = false;
+
+    // 自动色阶：根据亮度直方图拉伸亮度范围，暗画面也能用满整个字符集
+    bool autoLevels = false;
+
+    // 灰度模式：只处理亮度，单通道渲染并输出灰度视频
+    bool mono = false;
+
+    // 自定义字符集（UTF-8，从暗到亮排列），为空时使用ASCII_CHARS
+    std::string charset;
+
+    // 批量分析的帧数K（1表示逐帧）：一次读入K帧，各帧的缩放并行执行，
+    // 结果存放在一块连续内存中，再按顺序逐帧生成字符网格和渲染
+    int batchFrames = 1;
+
+    // 隔行更新间隔N（1表示关闭）：每帧只分析、渲染行号模N等于帧号模N的字符行，
+    // 其余行保留之前的内容，每帧工作量约为完整帧的1/N，N帧后整幅画面全部更新
+    int interlace = 1;
+
+    // 输入预读窗口（MB，0表示关闭）：本地文件由预读线程提前读入页缓存，解码不等待磁盘
+    int readaheadMB = ASCIIVideoConstants::READAHEAD_DEFAULT_MB;
+
+    // 无损输出：按FFV1、PNG、未压缩RGBA的顺序选择编码器，供剪辑和再编码使用，没有代际损失
+    bool lossless = false;
+
+    // 分段输出的每段时长（秒，0表示输出单个视频文件）：输出路径为.m3u8播放列表，
+    // 视频切成MPEG-TS分段随转换进度写出，各分段的编码并行进行
+    double segmentSeconds = 0.0;
+
+    // 字符网格输出文件（.mgrid），为空时不输出；每帧的字形编号和颜色平面按帧写入
+    std::string gridOutputPath;
+
+    // 覆盖率补偿：按所选字符覆盖率的倒数提亮字符颜色，使细笔画字符的亮度接近源画面
+    bool coverageCompensation = false;
+
+    // 字体文件（TTF/OTF等宽字体），为空时使用OpenCV的Hershey字体
+    std::string fontPath;
+
+    // 字体像素大小（em高度），0表示自动选择能放进字符格的最大字号
+    int fontPixelSize = 0;
+
+    // 加粗字体轮廓
+    bool fontBold = false;
+
+    // 背景填充模式：每个字符格先用平均颜色填满，再叠加对比色字符（或不画字符）
+    bool backgroundFill = false;
+    bool backgroundGlyphs = true;
+
+    // 感知时间滤波阈值（ΔE，0表示关闭）：字符格颜色与保持值的Lab距离小于阈值时保持不变，
+    // 阈值到两倍阈值之间在Lab空间与保持值折中，所有字符格都保持时整帧复用上一帧
+    double hysteresisDeltaE = 0.0;
+};
+
+/*
+ * 计算ASCII网格高度函数
+ * 按字符格的实际宽高比（ASCII_CHAR_WIDTH : ASCII_CHAR_HEIGHT）换算行数，
+ * 使输出图像与源画面宽高比一致；使用浮点运算并四舍五入，避免整数除法先截断
+ *
+ * 参数：
+ *   gridWidth: 网格宽度（字符数）
+ *   sourceWidth, sourceHeight: 源画面（或内容区域）尺寸
+ *
+ * 返回值：
+ *   int: 网格高度（字符数），至少为1
+ */
+inline int computeGridHeight(int gridWidth, int sourceWidth, int sourceHeight) {
+    double cellAspect = static_cast<double>(ASCIIVideoConstants::ASCII_CHAR_WIDTH) /
+                        ASCIIVideoConstants::ASCII_CHAR_HEIGHT;
+    double rows = static_cast<double>(gridWidth) * sourceHeight / sourceWidth * cellAspect;
+    return std::max(1, static_cast<int>(std::lround(rows)));
+}
+
+/*
+ * UTF-8解码函数
+ * 把UTF-8字符串解码为码位序列
+ *
+ * 返回值：
+ *   bool: 字符串不是合法的UTF-8时返回false
+ */
+inline bool decodeUTF8(const std::string& text, std::vector<char32_t>& codepoints) {
+    codepoints.clear();
+    for (size_t i = 0; i < text.size();) {
+        uchar lead = static_cast<uchar>(text[i]);
+        int length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        if (length == 0 || i + length > text.size()) {
+            return false;
+        }
+        char32_t cp = length == 1 ? lead : lead & (0x7F >> length);
+        for (int k = 1; k < length; ++k) {
+            uchar next = static_cast<uchar>(text[i + k]);
+            if ((next >> 6) != 0x2) {
+                return false;
+            }
+            cp = (cp << 6) | (next & 0x3F);
+        }
+        codepoints.push_back(cp);
+        i += length;
+    }
+    return true;
+}
+
+/*
+ * UTF-8编码函数
+ * 把单个码位编码为UTF-8字符串（用于输出字符集信息）
+ */
+inline std::string encodeUTF8(char32_t cp) {
+    std::string out;
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return out;
+}
+
+/*
+ * 全角字符判断函数
+ * 东亚全角字符（CJK表意文字、假名、谚文、全角符号等）在终端中占两个字符格
+ */
+inline bool isWideCodepoint(char32_t cp) {
+    return (cp >= 0x1100 && cp <= 0x115F) || (cp >= 0x2E80 && cp <= 0x303E) ||
+           (cp >= 0x3041 && cp <= 0x33FF) || (cp >= 0x3400 && cp <= 0x4DBF) ||
+           (cp >= 0x4E00 && cp <= 0x9FFF) || (cp >= 0xA000 && cp <= 0xA4CF) ||
+           (cp >= 0xAC00 && cp <= 0xD7A3) || (cp >= 0xF900 && cp <= 0xFAFF) ||
+           (cp >= 0xFE30 && cp <= 0xFE4F) || (cp >= 0xFF00 && cp <= 0xFF60) ||
+           (cp >= 0xFFE0 && cp <= 0xFFE6) || (cp >= 0x20000 && cp <= 0x3FFFD);
+}
+
+/*
+ * 视频编码器候选项：fourcc、显示名称和基准测试时使用的容器扩展名
+ */
+struct VideoCodecChoice {
+    int fourcc;
+    const char* name;
+    const char* container;
+};
+
+/*
+ * 视频编码器候选列表函数
+ * 不同系统和环境可能支持不同的编码器，打开输出时按顺序尝试直到找到一个可用的
+ *
+ * 参数：
+ *   lossless: true返回无损编码器（FFV1、PNG、未压缩RGBA），false返回常规有损编码器
+ *
+ * 无损列表中的每一项都经过解码比对（彩色和灰度输出都逐像素一致）；
+ * 不在列表中的：fourcc 0（OpenCV按I420写出，色度二次采样，细笔画颜色误差很大）、
+ * HuffYUV（灰度输出经YUV转换有±1误差）
+ */
+inline const std::vector<VideoCodecChoice>& videoCodecs(bool lossless) {
+    static const std::vector<VideoCodecChoice> lossy = {
+        {cv::VideoWriter::fourcc('m', 'p', '4', 'v'), "mp4v", ".mp4"},  // MP4V编码器
+        {cv::VideoWriter::fourcc('a', 'v', 'c', '1'), "avc1", ".mp4"},  // AVC1编码器
+        {cv::VideoWriter::fourcc('X', '2', '6', '4'), "X264", ".mp4"},  // H.264编码器
+        {cv::VideoWriter::fourcc('H', '2', '6', '4'), "H264", ".mp4"}   // 另一种H.264编码器
+    };
+    static const std::vector<VideoCodecChoice> exact = {
+        {cv::VideoWriter::fourcc('F', 'F', 'V', '1'), "FFV1", ".mkv"},  // FFV1：帧内无损，压缩率高
+        {cv::VideoWriter::fourcc('p', 'n', 'g', ' '), "PNG", ".avi"},   // 逐帧PNG：几乎所有FFmpeg构建都带有
+        {cv::VideoWriter::fourcc('R', 'G', 'B', 'A'), "RGBA", ".avi"}   // 未压缩RGB（带填充通道）
+    };
+    return lossless ? exact : lossy;
+}
+
+/*
+ * 分段输出编码器候选列表函数
+ * HLS客户端只接受MPEG-TS中的H.264等编码，mp4v（MPEG-4 Part 2）不能用于分段输出，
+ * 因此只尝试H.264的几种fourcc（OpenCV的FFmpeg后端需要带有H.264编码器）
+ */
+inline const std::vector<VideoCodecChoice>& segmentCodecs() {
+    static const std::vector<VideoCodecChoice> h264 = {
+        {cv::VideoWriter::fourcc('a', 'v', 'c', '1'), "avc1", ".ts"},
+        {cv::VideoWriter::fourcc('H', '2', '6', '4'), "H264", ".ts"},
+        {cv::VideoWriter::fourcc('X', '2', '6', '4'), "X264", ".ts"}
+    };
+    return h264;
+}
+
+/*
+ * InputPrefetcher类
+ * 本地输入文件的预读线程：让页缓存中已读入的范围始终领先解码位置一个窗口
+ *
+ * OpenCV的解码器自行打开和读取文件，读到未缓存的数据时解码线程只能等待磁盘；
+ * 预读线程对同一文件按顺序提前发出readahead，把即将解码的数据读进页缓存，
+ * 解码器之后的读取直接命中缓存。解码位置按 已解码帧数 / 总帧数 x 文件大小 估计，
+ * 码率不均匀造成的偏差由窗口大小吸收；预读范围不超过解码位置加窗口，不会把整个文件读进内存
+ *
+ * 只对本地普通文件启用，网络流、设备和管道直接跳过
+ */
+class InputPrefetcher {
+private:
+    int fd;                         // 预读用的文件描述符（与解码器各自打开）
+    off_t fileSize;                 // 文件大小（字节）
+    off_t windowBytes;              // 预读窗口（字节）
+    off_t decodePosition;           // 估计的解码位置
+    off_t prefetched;               // 已预读到的位置
+    std::mutex mutex;               // 保护位置和状态
+    std::condition_variable cond;   // 解码位置前进或请求退出
+    bool stopping;                  // 请求预读线程退出
+    std::thread worker;             // 预读线程
 
 public:
-    /*
-     * 构造函数
-     * 初始化帧计数器和字符集
-     */
-    EnhancedASCIIConverter() : frameCount(0) {
-        // 从常量命名空间复制ASCII字符集
-        // 使用字符串复制而不是指针引用，以便后续可能修改字符集
-        currentCharset = ASCIIVideoConstants::ASCII_CHARS;
+    InputPrefetcher()
+        : fd(-1), fileSize(0), windowBytes(0), decodePosition(0), prefetched(0), stopping(false) {}
+
+    ~InputPrefetcher() {
+        stop();
     }
 
+    InputPrefetcher(const InputPrefetcher&) = delete;
+    InputPrefetcher& operator=(const InputPrefetcher&) = delete;
+
     /*
-     * 主转换函数
-     * 将输入视频转换为彩色ASCII艺术视频
+     * 启动预读函数
      *
      * 参数：
-     *   inputPath: 输入视频文件的路径
-     *   outputPath: 输出视频文件的路径
-     *   asciiWidth: ASCII网格的宽度（每行字符数），默认80
-     *   quality: 质量参数（当前版本未使用，保留用于未来扩展）
+     *   path: 输入文件路径
+     *   window: 预读窗口（字节），0表示不预读
      *
      * 返回值：
-     *   bool: 转换成功返回true，失败返回false
-     *
-     * 工作流程：
-     *   1. 打开输入视频文件
-     *   2. 获取视频信息（分辨率、帧率、总帧数）
-     *   3. 计算输出视频参数
-     *   4. 创建视频写入器
-     *   5. 逐帧处理视频
-     *   6. 释放资源并输出结果
+     *   bool: 启动了预读线程返回true；不是本地普通文件或未启用时返回false（不是错误）
      */
-    bool convertToColorASCII(const std::string& inputPath, const std::string& outputPath,
-                             int asciiWidth = ASCIIVideoConstants::DEFAULT_ASCII_WIDTH, double quality = 1.0) {
-        // 步骤1：打开输入视频文件
-        cv::VideoCapture cap(inputPath);
-        if (!cap.isOpened()) {
-            std::cerr << "无法打开视频文件: " << inputPath << std::endl;
+    bool start(const std::string& path, size_t window) {
+        struct stat info;
+        if (window == 0 || ::stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+            return false;
+        }
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
             return false;
         }
+        fileSize = info.st_size;
+        windowBytes = static_cast<off_t>(window);
+        decodePosition = 0;
+        prefetched = 0;
+        stopping = false;
 
-        // 步骤2：获取视频基本信息
-        double fps = cap.get(cv::CAP_PROP_FPS);  // 帧率（每秒帧数）
-        int totalFrames = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_COUNT));  // 总帧数
-        int originalWidth = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH));  // 原始宽度
-        int originalHeight = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT));  // 原始高度
+        // 告知内核按顺序访问：内核自身的预读窗口加倍，已读过的页面优先回收
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        worker = std::thread(&InputPrefetcher::prefetchLoop, this);
+        return true;
+    }
 
-        // 显示视频信息，让用户了解处理的是什么视频
-        std::cout << "视频信息: " << originalWidth << "x" << originalHeight
-        << ", " << fps << "fps, " << totalFrames << "帧" << std::endl;
+    /*
+     * 更新解码进度函数（解码循环每读一帧调用一次）
+     * 总帧数未知时无法估计解码位置，只预读开头的一个窗口
+     */
+    void advance(int framesDecoded, int totalFrames) {
+        if (fd < 0 || totalFrames <= 0) {
+            return;
+        }
+        off_t position = static_cast<off_t>(static_cast<double>(fileSize) *
+                                            std::min(framesDecoded, totalFrames) / totalFrames);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (position <= decodePosition) {
+                return;
+            }
+            decodePosition = position;
+        }
+        cond.notify_one();
+    }
 
-        // 步骤3：计算输出视频参数
-        // 计算ASCII网格高度，保持原始视频的宽高比
-        // 乘以0.5是因为字符通常比像素高，需要调整纵横比
-        int asciiHeight = static_cast<int>((asciiWidth * originalHeight / originalWidth) * 0.5);
+    // 停止预读线程并关闭文件
+    void stop() {
+        if (worker.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            cond.notify_one();
+            worker.join();
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
 
-        // 计算输出视频的实际分辨率
-        // 每个ASCII字符占据固定像素大小，所以总分辨率 = 字符数 × 字符像素大小
-        cv::Size frameSize(asciiWidth * ASCIIVideoConstants::ASCII_CHAR_WIDTH,
-                           asciiHeight * ASCIIVideoConstants::ASCII_CHAR_HEIGHT);
+private:
+    /*
+     * 预读线程主循环
+     * 已预读位置落后于 解码位置 + 窗口 时按块预读，追上后等待解码位置前进
+     */
+    void prefetchLoop() {
+        while (true) {
+            off_t from, length;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [this] {
+                    return stopping || prefetched < std::min(fileSize, decodePosition + windowBytes);
+                });
+                if (stopping) {
+                    return;
+                }
+                // 解码已越过的部分不再预读
+                from = std::max(prefetched, decodePosition);
+                length = std::min(static_cast<off_t>(ASCIIVideoConstants::READAHEAD_CHUNK_BYTES),
+                                  std::min(fileSize, decodePosition + windowBytes) - from);
+            }
 
-        std::cout << "输出尺寸: " << frameSize.width << "x" << frameSize.height << std::endl;
-        std::cout << "ASCII网格: " << asciiWidth << "x" << asciiHeight << " 字符" << std::endl;
-        std::cout << "使用字符集: " << currentCharset.length() << " 个字符" << std::endl;
+            // 在锁外读入：慢速磁盘上等待的是预读线程，解码线程随后直接命中页缓存
+#ifdef __linux__
+            ::readahead(fd, from, static_cast<size_t>(length));
+#else
+            ::posix_fadvise(fd, from, length, POSIX_FADV_WILLNEED);
+#endif
 
-        // 步骤4：创建视频写入器
-        cv::VideoWriter writer;
-        bool writerOpened = false;
-
-        // 尝试多种视频编码器，不同系统和环境可能支持不同的编码器
-        // 按顺序尝试直到找到一个可用的编码器
-        std::vector<std::vector<int>> codecList = {
-            {cv::VideoWriter::fourcc('m', 'p', '4', 'v')},  // MP4V编码器
-            {cv::VideoWriter::fourcc('a', 'v', 'c', '1')},  // AVC1编码器
-            {cv::VideoWriter::fourcc('X', '2', '6', '4')},  // H.264编码器
-            {cv::VideoWriter::fourcc('H', '2', '6', '4')}   // 另一种H.264编码器
-        };
+            std::lock_guard<std::mutex> lock(mutex);
+            prefetched = from + length;
+        }
+    }
+};
 
-        for (const auto& codec : codecList) {
-            writer.open(outputPath, codec[0], fps, frameSize);
-            if (writer.isOpened()) {
-                writerOpened = true;
-                std::cout << "使用编码器: " << std::hex << codec[0] << std::dec << std::endl;
-                break;
+/*
+ * LinearLightLUT类
+ * sRGB与线性光之间的查找表，用于伽马正确的缩放（平均）
+ *
+ * 直接对sRGB字节求平均会使高反差细节整体偏暗，进而影响字符选择；
+ * 先经256项查找表转换到线性光，平均后再经反向查找表转回sRGB，
+ * 每个像素只多一次查表，不需要浮点幂运算
+ */
+class LinearLightLUT {
+public:
+    uint16_t toLinear[256];                                      // sRGB字节 -> 12位线性光
+    uchar toSRGB[ASCIIVideoConstants::LINEAR_LIGHT_LEVELS];      // 12位线性光 -> sRGB字节
+    cv::Mat toLinearMat;                                         // toLinear的cv::Mat形式，供cv::LUT使用
+
+    // 全局共享的只读实例，第一次使用时建表
+    static const LinearLightLUT& instance() {
+        static const LinearLightLUT table;
+        return table;
+    }
+
+    /*
+     * 线性光网格转sRGB函数
+     * 把CV_16UC3的线性光网格逐元素经反向查找表转换为CV_8UC3
+     * 网格只有字符格数量级大小，成本可以忽略
+     */
+    void linearToSRGB(const cv::Mat& linear, cv::Mat& srgb) const {
+        srgb.create(linear.rows, linear.cols, CV_8UC3);
+        for (int y = 0; y < linear.rows; ++y) {
+            const uint16_t* src = linear.ptr<uint16_t>(y);
+            uchar* dst = srgb.ptr<uchar>(y);
+            for (int i = 0; i < linear.cols * 3; ++i) {
+                dst[i] = toSRGB[src[i]];
             }
         }
+    }
 
-        if (!writerOpened) {
-            std::cerr << "无法创建输出视频文件: " << outputPath << std::endl;
-            cap.release();
+private:
+    LinearLightLUT() : toLinearMat(1, 256, CV_16UC1) {
+        const int maxLinear = ASCIIVideoConstants::LINEAR_LIGHT_LEVELS - 1;
+
+        // sRGB标准传递函数
+        for (int v = 0; v < 256; ++v) {
+            double c = v / 255.0;
+            double linear = c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+            toLinear[v] = static_cast<uint16_t>(std::lround(linear * maxLinear));
+            toLinearMat.at<uint16_t>(0, v) = toLinear[v];
+        }
+
+        for (int l = 0; l <= maxLinear; ++l) {
+            double linear = static_cast<double>(l) / maxLinear;
+            double c = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+            toSRGB[l] = static_cast<uchar>(std::lround(std::min(1.0, std::max(0.0, c)) * 255.0));
+        }
+    }
+};
+
+/*
+ * MosaicInputDecoder类
+ * 拼接模式下单个输入视频的解码器
+ * 每个输入拥有独立的解码线程：读取帧、缩放到所属子网格大小，再连同时间戳放入有界队列；
+ * 启用 --linear 时与单输入模式一样在线性光下缩放
+ * 合成器按时间戳从各个队列取帧，某个输入解码慢不会阻塞其他输入
+ */
+class MosaicInputDecoder {
+private:
+    // 队列中的一帧：已缩放到子网格大小的图像及其时间戳（毫秒）
+    struct TimedTile {
+        cv::Mat tile;
+        double timestampMs;
+    };
+
+    cv::VideoCapture cap;           // 输入视频捕获对象
+    std::string path;               // 输入视频路径
+    cv::Size tileSize;              // 子网格尺寸（字符数）
+    double fps;                     // 输入帧率
+    const LinearLightLUT* linearLUT;  // 线性光查找表（未启用 --linear 时为nullptr）
+
+    std::deque<TimedTile> queue;    // 解码帧队列
+    std::mutex mutex;               // 保护队列和状态
+    std::condition_variable cond;   // 队列状态变化通知
+    bool finished;                  // 解码线程已读到视频结尾
+    bool stopping;                  // 请求解码线程退出
+    std::thread worker;             // 解码线程
+
+    cv::Mat current;                // 合成器当前显示的帧
+
+    size_t readaheadBytes;          // 预读窗口（字节）
+    InputPrefetcher prefetcher;     // 输入预读线程
+
+public:
+    MosaicInputDecoder(const std::string& inputPath, cv::Size tile, size_t readahead, const LinearLightLUT* linear)
+        : path(inputPath), tileSize(tile), fps(0.0), linearLUT(linear), finished(false), stopping(false),
+          current(tile, CV_8UC3, cv::Scalar(0, 0, 0)), readaheadBytes(readahead) {}
+
+    // 析构时通知解码线程退出并等待其结束，保证线程和视频资源被释放
+    ~MosaicInputDecoder() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cond.notify_all();
+        if (worker.joinable()) {
+            worker.join();
+        }
+        prefetcher.stop();
+        cap.release();
+    }
+
+    MosaicInputDecoder(const MosaicInputDecoder&) = delete;
+    MosaicInputDecoder& operator=(const MosaicInputDecoder&) = delete;
+
+    /*
+     * 打开输入视频并读取帧率
+     * 返回值：打开成功返回true
+     */
+    bool open() {
+        if (!cap.open(path)) {
+            std::cerr << "无法打开视频文件: " << path << std::endl;
             return false;
         }
+        fps = cap.get(cv::CAP_PROP_FPS);
+        if (fps <= 0.0) {
+            fps = 25.0;  // 部分容器不报告帧率，使用常见默认值
+        }
+        return true;
+    }
 
-        // 步骤5：逐帧处理视频
-        cv::Mat frame, resized;  // 原始帧和调整大小后的帧
-        frameCount = 0;  // 重置帧计数器
+    double getFps() const { return fps; }
 
-        std::cout << "开始转换视频..." << std::endl;
+    double getDurationMs() const {
+        return cap.get(cv::CAP_PROP_FRAME_COUNT) * 1000.0 / fps;
+    }
 
-        // 显示字符集信息，帮助用户理解亮度到字符的映射关系
-        testCharacterDisplay();
+    const std::string& getPath() const { return path; }
 
-        // 主处理循环：读取、处理、写入每一帧
+    // 启动预读线程和解码线程
+    void start() {
+        prefetcher.start(path, readaheadBytes);
+        worker = std::thread(&MosaicInputDecoder::decodeLoop, this);
+    }
+
+    /*
+     * 取出时间戳不晚于targetMs的最新一帧
+     * 队列为空且解码未结束时等待解码线程；输入结束后保持最后一帧
+     *
+     * 返回值：
+     *   const cv::Mat&: 当前应显示的子网格图像
+     */
+    const cv::Mat& frameAt(double targetMs) {
+        std::unique_lock<std::mutex> lock(mutex);
         while (true) {
-            cap >> frame;  // 从视频捕获对象读取下一帧
-            if (frame.empty()) {
-                break;  // 如果读取到空帧，说明视频已结束
+            cond.wait(lock, [this] { return !queue.empty() || finished; });
+            if (queue.empty() || queue.front().timestampMs > targetMs) {
+                break;  // 输入已结束，或下一帧属于未来
             }
+            current = queue.front().tile;
+            queue.pop_front();
+            cond.notify_all();  // 腾出队列空间，唤醒解码线程
+        }
+        return current;
+    }
 
-            // 5.1 调整帧大小到ASCII网格尺寸
-            // 使用INTER_AREA插值方法，适合缩小图像
-            cv::resize(frame, resized, cv::Size(asciiWidth, asciiHeight), 0, 0, cv::INTER_AREA);
+    // 解码线程已结束且队列中没有剩余帧
+    bool exhausted() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return finished && queue.empty();
+    }
 
-            // 5.2 将调整大小后的帧转换为ASCII艺术帧
-            cv::Mat asciiFrame = generateColorASCIIFrame(resized);
+private:
+    /*
+     * 解码线程主循环
+     * 读取帧 -> 缩放到子网格 -> 按时间戳入队；队列满时等待合成器消费
+     */
+    void decodeLoop() {
+        cv::Mat frame, linearFrame, linearTile;
+        int index = 0;
+        double lastTimestamp = -1.0;
+        const int totalFrames = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_COUNT));
 
-            // 5.3 将ASCII艺术帧写入输出视频
-            writer.write(asciiFrame);
+        while (true) {
+            cap >> frame;
+            if (frame.empty()) {
+                break;
+            }
+            prefetcher.advance(index + 1, totalFrames);
 
-            // 5.4 更新帧计数器并显示进度
-            frameCount++;
-            if (frameCount % 30 == 0) {  // 每处理30帧显示一次进度
-                double progress = (frameCount * 100.0) / totalFrames;
-                std::cout << "进度: " << frameCount << "/" << totalFrames
-                << " 帧 (" << std::fixed << std::setprecision(1) << progress << "%)" << std::endl;
+            // 优先使用容器给出的时间戳；不可用或不单调时按帧序号推算
+            double timestamp = cap.get(cv::CAP_PROP_POS_MSEC);
+            if (timestamp <= lastTimestamp || (timestamp <= 0.0 && index > 0)) {
+                timestamp = index * 1000.0 / fps;
             }
-        }
+            lastTimestamp = timestamp;
+            index++;
 
-        // 步骤6：释放资源
-        cap.release();   // 释放视频捕获对象
-        writer.release(); // 释放视频写入对象
+            // 在解码线程内完成缩放，队列里只保存很小的子网格图像
+            cv::Mat tile;
+            if (linearLUT) {
+                cv::LUT(frame, linearLUT->toLinearMat, linearFrame);
+                cv::resize(linearFrame, linearTile, tileSize, 0, 0, cv::INTER_AREA);
+                linearLUT->linearToSRGB(linearTile, tile);
+            } else {
+                cv::resize(frame, tile, tileSize, 0, 0, cv::INTER_AREA);
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] {
+                return stopping || static_cast<int>(queue.size()) < ASCIIVideoConstants::MOSAIC_QUEUE_CAPACITY;
+            });
+            if (stopping) {
+                return;
+            }
+            queue.push_back({tile, timestamp});
+            cond.notify_all();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+        cond.notify_all();
+    }
+};
+
+/*
+ * LabColorLUT类
+ * BGR与CIELAB之间的快速转换，用于感知颜色距离（ΔE）
+ *
+ * 正向（BGR -> Lab）：在BGR立方体上建 33x33x33 的节点表，节点间三线性插值，
+ * 每次转换只需8次查表和整数乘加，不需要逐像素的幂运算和立方根
+ * 反向（Lab -> BGR）：立方、矩阵乘法加一次伽马查表
+ * Lab值以 LAB_FIXED_SCALE 倍定点整数表示
+ */
+class LabColorLUT {
+private:
+    static constexpr int N = ASCIIVideoConstants::LAB_GRID_NODES;
+    static constexpr int S = ASCIIVideoConstants::LAB_FIXED_SCALE;
+
+    std::vector<int16_t> forward;   // [r][g][b][3] -> L*, a*, b*（定点）
+    const LinearLightLUT& gamma;    // 反向转换使用的线性光 -> sRGB查找表
+    uchar nodeIndex[256];           // 通道值所在的节点区间
+    uchar nodeFraction[256];        // 通道值在区间内的位置（以1/8为单位）
+
+public:
+    // 全局共享的只读实例，第一次使用时建表
+    static const LabColorLUT& instance() {
+        static const LabColorLUT table;
+        return table;
+    }
+
+    /*
+     * BGR转Lab函数
+     * 参数：
+     *   bgr: 8位BGR颜色
+     *   lab: 输出的 L*, a*, b*（乘以LAB_FIXED_SCALE的整数）
+     */
+    void toLab(const cv::Vec3b& bgr, int lab[3]) const {
+        // 每个通道：所在节点区间及区间内位置（0-8）
+        int ib = nodeIndex[bgr[0]], fb = nodeFraction[bgr[0]];
+        int ig = nodeIndex[bgr[1]], fg = nodeFraction[bgr[1]];
+        int ir = nodeIndex[bgr[2]], fr = nodeFraction[bgr[2]];
+
+        const int16_t* base = &forward[((ir * N + ig) * N + ib) * 3];
+        const int db = 3, dg = N * 3, dr = N * N * 3;
+
+        for (int ch = 0; ch < 3; ++ch) {
+            const int16_t* p = base + ch;
+            int c00 = p[0] * (8 - fb) + p[db] * fb;
+            int c01 = p[dg] * (8 - fb) + p[dg + db] * fb;
+            int c10 = p[dr] * (8 - fb) + p[dr + db] * fb;
+            int c11 = p[dr + dg] * (8 - fb) + p[dr + dg + db] * fb;
+            int c0 = c00 * (8 - fg) + c01 * fg;
+            int c1 = c10 * (8 - fg) + c11 * fg;
+            int value = c0 * (8 - fr) + c1 * fr;  // 放大了 8*8*8 = 512 倍
+            lab[ch] = value >= 0 ? (value + 256) >> 9 : -((-value + 256) >> 9);
+        }
+    }
+
+    /*
+     * Lab转BGR函数
+     * 反向转换不需要立方根：f⁻¹(t) 只是立方，之后做一次XYZ到线性RGB的矩阵乘法，
+     * 再用LinearLightLUT的反向查找表得到sRGB字节，避免逐像素的幂运算
+     *
+     * 参数：
+     *   lab: L*, a*, b*（乘以LAB_FIXED_SCALE的整数）
+     *
+     * 返回值：
+     *   cv::Vec3b: 对应的BGR颜色，超出色域时截断
+     */
+    cv::Vec3b toBGR(const int lab[3]) const {
+        float fy = (static_cast<float>(lab[0]) / S + 16.0f) / 116.0f;
+        float fx = fy + static_cast<float>(lab[1]) / (S * 500.0f);
+        float fz = fy - static_cast<float>(lab[2]) / (S * 200.0f);
+        float x = labFInverse(fx) * static_cast<float>(WHITE_X);
+        float y = labFInverse(fy) * static_cast<float>(WHITE_Y);
+        float z = labFInverse(fz) * static_cast<float>(WHITE_Z);
+
+        float linear[3] = {
+            0.0556434f * x - 0.2040259f * y + 1.0572252f * z,   // B
+            -0.9692660f * x + 1.8760108f * y + 0.0415560f * z,  // G
+            3.2404542f * x - 1.5371385f * y - 0.4985314f * z    // R
+        };
+
+        const int maxLinear = ASCIIVideoConstants::LINEAR_LIGHT_LEVELS - 1;
+        cv::Vec3b bgr;
+        for (int ch = 0; ch < 3; ++ch) {
+            int level = static_cast<int>(linear[ch] * maxLinear + 0.5f);
+            bgr[ch] = gamma.toSRGB[std::max(0, std::min(maxLinear, level))];
+        }
+        return bgr;
+    }
+
+    // 两个Lab颜色的ΔE76距离平方（定点单位）
+    static int distanceSquared(const int a[3], const int b[3]) {
+        int dl = a[0] - b[0], da = a[1] - b[1], db = a[2] - b[2];
+        return dl * dl + da * da + db * db;
+    }
+
+private:
+    LabColorLUT() : forward(N * N * N * 3), gamma(LinearLightLUT::instance()) {
+        // 节点 i 对应通道值 255*i/32，0和255都正好落在节点上
+        for (int v = 0; v < 256; ++v) {
+            int position = (v * (N - 1) * 8 + 127) / 255;  // 0 - 256
+            int index = std::min(position >> 3, N - 2);
+            nodeIndex[v] = static_cast<uchar>(index);
+            nodeFraction[v] = static_cast<uchar>(position - index * 8);
+        }
+
+        // 正向表
+        auto nodeValue = [](int node) { return 255.0 * node / (N - 1); };
+        for (int r = 0; r < N; ++r) {
+            for (int g = 0; g < N; ++g) {
+                for (int b = 0; b < N; ++b) {
+                    double lab[3];
+                    srgbToLab(nodeValue(r), nodeValue(g), nodeValue(b), lab);
+                    int16_t* out = &forward[((r * N + g) * N + b) * 3];
+                    for (int ch = 0; ch < 3; ++ch) {
+                        out[ch] = static_cast<int16_t>(std::lround(lab[ch] * S));
+                    }
+                }
+            }
+        }
+    }
+
+    // D65白点
+    static constexpr double WHITE_X = 0.95047;
+    static constexpr double WHITE_Y = 1.0;
+    static constexpr double WHITE_Z = 1.08883;
+
+    static double srgbToLinear(double c) {
+        return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+    }
+
+    static double labF(double t) {
+        return t > 216.0 / 24389.0 ? std::cbrt(t) : (24389.0 / 27.0 * t + 16.0) / 116.0;
+    }
+
+    static float labFInverse(float t) {
+        return t * t * t > 216.0f / 24389.0f ? t * t * t : (116.0f * t - 16.0f) * 27.0f / 24389.0f;
+    }
+
+    // 建表用的精确转换（只在构造时调用）
+    static void srgbToLab(double r8, double g8, double b8, double lab[3]) {
+        double r = srgbToLinear(r8 / 255.0), g = srgbToLinear(g8 / 255.0), b = srgbToLinear(b8 / 255.0);
+        double x = (0.4124564 * r + 0.3575761 * g + 0.1804375 * b) / WHITE_X;
+        double y = (0.2126729 * r + 0.7151522 * g + 0.0721750 * b) / WHITE_Y;
+        double z = (0.0193339 * r + 0.1191920 * g + 0.9503041 * b) / WHITE_Z;
+        double fx = labF(x), fy = labF(y), fz = labF(z);
+        lab[0] = 116.0 * fy - 16.0;
+        lab[1] = 500.0 * (fx - fy);
+        lab[2] = 200.0 * (fy - fz);
+    }
+};
+
+/*
+ * GlyphAtlas类
+ * 字形图集：启动时把字符集中每个字符用putText绘制一次，保存为8位灰度（透明度）图块，
+ * 之后每个字符格只需把图块按颜色缩放后拷贝到输出帧，不再逐字符调用putText
+ *
+ * 图块大小：ASCII_CHAR_HEIGHT 行 x (ASCII_CHAR_WIDTH + 2*ATLAS_GLYPH_PADDING) 列
+ * 字符在图块中的位置与putText在字符格中的位置完全相同，伸出字符格的部分落在留白里，
+ * 绘制时与相邻字符格取最大值合成，黑色背景上与putText的抗锯齿结果一致
+ *
+ * 也可以用FreeType从TTF/OTF字体光栅化图块（buildFromFont），结果缓存在磁盘上，
+ * 之后启动直接读取，绘制路径与Hershey字体完全相同
+ *
+ * 默认字符集的图集在编译时内嵌（miku_glyphs.h），启动时直接拷贝，不需要绘制；
+ * 字形按码位（UTF-8解码后）建立，方块元素、阴影和制表符由程序直接绘制，保证相邻字符格无缝拼接；
+ * 字符集含全角字符时每个字形占两个字符格（span为2），半角字符在两格中居中
+ */
+class GlyphAtlas {
+private:
+    int span;                       // 每个字形占的字符格数（1或2）
+    int tileWidth;                  // 图块宽度（含左右留白）
+    int tileHeight;                 // 图块高度
+    std::vector<uchar> alpha;       // 所有字形的透明度数据，按字形顺序连续存放
+    std::vector<int> columnBegin;   // 每个字形第一个非空列（空白字符为tileWidth）
+    std::vector<int> columnEnd;     // 每个字形最后一个非空列之后
+    std::vector<std::vector<uchar>> scaledAlpha;  // scaledAlpha[f]: 放大f倍的全部图块（未建立时为空）
+
+public:
+    GlyphAtlas()
+        : span(1),
+          tileWidth(ASCIIVideoConstants::ASCII_CHAR_WIDTH + 2 * ASCIIVideoConstants::ATLAS_GLYPH_PADDING),
+          tileHeight(ASCIIVideoConstants::ASCII_CHAR_HEIGHT) {}
+
+    // 每个字形在输出帧中占的像素宽度
+    int cellWidth() const {
+        return span * ASCIIVideoConstants::ASCII_CHAR_WIDTH;
+    }
+
+    /*
+     * 建立图集函数
+     * 参数：
+     *   charset: 字符集码位，第i个码位对应字形编号i
+     *   glyphSpan: 每个字形占的字符格数（1或2）
+     * 返回值：
+     *   bool: 字符集含有Hershey字体无法绘制的字符（需要 --font）时返回false
+     */
+    bool build(const std::vector<char32_t>& charset, int glyphSpan) {
+        setSpan(glyphSpan);
+        const int pad = ASCIIVideoConstants::ATLAS_GLYPH_PADDING;
+        const int count = static_cast<int>(charset.size());
+        alpha.assign(static_cast<size_t>(count) * tileWidth * tileHeight, 0);
+
+        for (int i = 0; i < count; ++i) {
+            uchar* tile = &alpha[static_cast<size_t>(i) * tileWidth * tileHeight];
+            if (drawProceduralGlyph(charset[i], tile)) {
+                continue;
+            }
+            if (charset[i] >= 0x80) {
+                std::cerr << "错误: 字符 " << encodeUTF8(charset[i]) << " 需要用 --font 指定字体" << std::endl;
+                return false;
+            }
+            // 与逐字符putText相同的字体、字号、位置（基线在字符格底部上方2像素），全角布局时水平居中
+            cv::Mat tileMat(tileHeight, tileWidth, CV_8UC1, tile);
+            cv::putText(tileMat, std::string(1, static_cast<char>(charset[i])),
+                        cv::Point(pad + (span - 1) * ASCIIVideoConstants::ASCII_CHAR_WIDTH / 2, tileHeight - 2),
+                        cv::FONT_HERSHEY_SIMPLEX, ASCIIVideoConstants::ASCII_FONT_SIZE,
+                        cv::Scalar(255), 1, cv::LINE_AA);
+        }
+        recordColumnRanges();
+        return true;
+    }
+
+    /*
+     * 读取内嵌图集函数
+     * 字符集、图块大小与编译时内嵌的默认图集一致时直接拷贝，跳过绘制
+     *
+     * 返回值：
+     *   bool: 未内嵌图集或字符集不一致时返回false，调用方改为运行时绘制
+     */
+    bool loadEmbedded(const std::string& charset, int glyphSpan) {
+#ifdef MIKU_HAS_EMBEDDED_GLYPHS
+        setSpan(glyphSpan);
+        if (charset != EmbeddedGlyphs::CHARSET || tileWidth != EmbeddedGlyphs::TILE_WIDTH ||
+            tileHeight != EmbeddedGlyphs::TILE_HEIGHT) {
+            return false;
+        }
+        alpha.assign(std::begin(EmbeddedGlyphs::ALPHA), std::end(EmbeddedGlyphs::ALPHA));
+        columnBegin.assign(std::begin(EmbeddedGlyphs::COLUMN_BEGIN), std::end(EmbeddedGlyphs::COLUMN_BEGIN));
+        columnEnd.assign(std::begin(EmbeddedGlyphs::COLUMN_END), std::end(EmbeddedGlyphs::COLUMN_END));
+        return true;
+#else
+        (void)charset;
+        (void)glyphSpan;
+        return false;
+#endif
+    }
+
+    /*
+     * 读取图块函数
+     * 直接使用已绘制好的图块（字符网格文件头中保存的图集），跳过绘制
+     *
+     * 参数：
+     *   glyphSpan: 每个字形占的字符格数（1或2）
+     *   width: 图块宽度
+     *   tiles: 按字形顺序排列的透明度图块
+     *   count: 字形数量
+     *
+     * 返回值：
+     *   bool: 图块宽度或数据长度与字形数量不符时返回false
+     */
+    bool loadTiles(int glyphSpan, int width, const std::vector<uchar>& tiles, int count) {
+        setSpan(glyphSpan);
+        if (width != tileWidth || tiles.size() != static_cast<size_t>(count) * tileWidth * tileHeight) {
+            return false;
+        }
+        alpha = tiles;
+        recordColumnRanges();
+        return true;
+    }
+
+    /*
+     * 生成内嵌图集头文件函数
+     * 把当前图集写成C++头文件（miku_glyphs.h），重新编译后默认字符集不再需要运行时绘制
+     *
+     * 参数：
+     *   path: 输出头文件路径
+     *   charset: 图集对应的字符集（UTF-8）
+     */
+    bool writeHeader(const std::string& path, const std::string& charset) const {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            std::cerr << "无法写入文件: " << path << std::endl;
+            return false;
+        }
+        const int count = static_cast<int>(columnBegin.size());
+
+        std::string escaped;
+        for (char c : charset) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+
+        out << "// 内嵌的默认字形图集，由 ./miku --dump-glyph-header 生成，请勿手工修改\n"
+            << "// FONT_HERSHEY_SIMPLEX，字号 " << ASCIIVideoConstants::ASCII_FONT_SIZE
+            << "，抗锯齿，OpenCV " << CV_VERSION << "\n"
+            << "#ifndef MIKU_GLYPHS_H\n"
+            << "#define MIKU_GLYPHS_H\n\n"
+            << "namespace EmbeddedGlyphs {\n"
+            << "    constexpr int TILE_WIDTH = " << tileWidth << ";\n"
+            << "    constexpr int TILE_HEIGHT = " << tileHeight << ";\n"
+            << "    constexpr const char* CHARSET = \"" << escaped << "\";\n\n";
+
+        auto writeColumns = [&out, count](const char* name, const std::vector<int>& values) {
+            out << "    constexpr unsigned char " << name << "[" << count << "] = {";
+            for (int i = 0; i < count; ++i) {
+                out << (i % 16 == 0 ? "\n        " : " ") << values[i] << ",";
+            }
+            out << "\n    };\n\n";
+        };
+        writeColumns("COLUMN_BEGIN", columnBegin);
+        writeColumns("COLUMN_END", columnEnd);
+
+        out << "    constexpr unsigned char ALPHA[" << alpha.size() << "] = {\n";
+        for (int i = 0; i < count; ++i) {
+            out << "        // " << i << "\n";
+            for (int y = 0; y < tileHeight; ++y) {
+                out << "       ";
+                for (int x = 0; x < tileWidth; ++x) {
+                    out << " " << static_cast<int>(alpha[(static_cast<size_t>(i) * tileHeight + y) * tileWidth + x]) << ",";
+                }
+                out << "\n";
+            }
+        }
+        out << "    };\n"
+            << "}\n\n"
+            << "#endif\n";
+        return static_cast<bool>(out);
+    }
+
+    /*
+     * 从字体文件建立图集函数（带磁盘缓存）
+     * 参数：
+     *   charset: 字符集码位
+     *   glyphSpan: 每个字形占的字符格数（1或2）
+     *   fontPath: TTF/OTF字体文件路径
+     *   pixelSize: 字体像素大小，0表示自动选择
+     *   bold: 是否加粗轮廓
+     * 返回值：
+     *   bool: 成功返回true；字体无法加载或未编译FreeType支持时返回false
+     *
+     * 缓存：图集按（字体路径、修改时间、字号、加粗、图块大小、字符集）计算键值，
+     * 保存在 $XDG_CACHE_HOME/miku（或 ~/.cache/miku）下，键值相同时直接读取，不再光栅化
+     */
+    bool buildFromFont(const std::vector<char32_t>& charset, int glyphSpan, const std::string& fontPath,
+                       int pixelSize, bool bold) {
+        setSpan(glyphSpan);
+        struct stat fontStat;
+        if (stat(fontPath.c_str(), &fontStat) != 0) {
+            std::cerr << "无法访问字体文件: " << fontPath << std::endl;
+            return false;
+        }
+
+        // 计算缓存键值（FNV-1a）
+        uint64_t key = 1469598103934665603ULL;
+        auto mix = [&key](const void* data, size_t size) {
+            const uchar* bytes = static_cast<const uchar*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                key = (key ^ bytes[i]) * 1099511628211ULL;
+            }
+        };
+        int64_t mtime = static_cast<int64_t>(fontStat.st_mtime);
+        int params[4] = {pixelSize, bold ? 1 : 0, tileWidth, tileHeight};
+        mix(fontPath.data(), fontPath.size());
+        mix(&mtime, sizeof(mtime));
+        mix(params, sizeof(params));
+        mix(charset.data(), charset.size() * sizeof(char32_t));
+
+        std::string cachePath = cacheFilePath(key);
+        if (!cachePath.empty() && loadCache(cachePath, key, static_cast<int>(charset.size()))) {
+            std::cout << "字形图集: 读取缓存 " << cachePath << std::endl;
+            return true;
+        }
+
+#ifdef MIKU_WITH_FREETYPE
+        if (!rasterizeFont(charset, fontPath, pixelSize, bold)) {
+            return false;
+        }
+        if (!cachePath.empty()) {
+            saveCache(cachePath, key);
+        }
+        return true;
+#else
+        std::cerr << "错误: 程序编译时未启用FreeType支持（需要定义MIKU_WITH_FREETYPE并链接freetype2）" << std::endl;
+        return false;
+#endif
+    }
+
+    // 字形数量
+    int glyphCount() const {
+        return static_cast<int>(columnBegin.size());
+    }
+
+    // 图块宽度（含左右留白）和全部图块数据，写入字符网格文件头
+    int paddedWidth() const {
+        return tileWidth;
+    }
+    const std::vector<uchar>& tiles() const {
+        return alpha;
+    }
+
+    /*
+     * 建立放大图块函数
+     * 把每个字形图块按factor倍最近邻放大一次，可变密度模式的粗字符格直接贴图，不再逐格调用putText；
+     * 最近邻放大不改变字形的覆盖率（覆盖率补偿增益照常适用），方块元素放大后仍然无缝拼接
+     */
+    void buildScaled(int factor) {
+        if (scaledAlpha.size() <= static_cast<size_t>(factor)) {
+            scaledAlpha.resize(factor + 1);
+        }
+        std::vector<uchar>& scaled = scaledAlpha[factor];
+        const size_t tileBytes = static_cast<size_t>(tileWidth) * tileHeight;
+        scaled.assign(tileBytes * factor * factor * glyphCount(), 0);
+        for (int i = 0; i < glyphCount(); ++i) {
+            const cv::Mat tile(tileHeight, tileWidth, CV_8UC1, &alpha[i * tileBytes]);
+            cv::Mat scaledTile(tileHeight * factor, tileWidth * factor, CV_8UC1, &scaled[i * tileBytes * factor * factor]);
+            cv::resize(tile, scaledTile, scaledTile.size(), 0, 0, cv::INTER_NEAREST);
+        }
+    }
+
+    /*
+     * 字形覆盖率函数
+     * 返回值：第glyph个字形的透明度总和占整个字符格（全部不透明）的比例，0-1
+     */
+    double coverage(int glyph) const {
+        const uchar* tile = &alpha[static_cast<size_t>(glyph) * tileWidth * tileHeight];
+        long sum = 0;
+        for (int i = 0; i < tileWidth * tileHeight; ++i) {
+            sum += tile[i];
+        }
+        return static_cast<double>(sum) / (255.0 * cellWidth() * tileHeight);
+    }
+
+    /*
+     * 彩色绘制函数
+     * 把第glyph个字形以color颜色绘制到CV_8UC3输出帧的字符格 (cellX, cellY)
+     * 每个像素：输出 = max(原值, 透明度 * 颜色 / 255)
+     */
+    void blitColor(cv::Mat& frame, int cellX, int cellY, int glyph, const cv::Vec3b& color) const {
+        int x0, x1;
+        if (!columnRange(frame.cols, cellX, glyph, x0, x1)) {
+            return;
+        }
+        const int originX = cellX * cellWidth() - ASCIIVideoConstants::ATLAS_GLYPH_PADDING;
+        const uchar* tile = &alpha[static_cast<size_t>(glyph) * tileWidth * tileHeight];
+
+        for (int y = 0; y < tileHeight; ++y) {
+            const uchar* src = tile + y * tileWidth;
+            uchar* dst = frame.ptr<uchar>(cellY * tileHeight + y);
+            for (int x = x0; x < x1; ++x) {
+                int a = src[x];
+                uchar* out = dst + (originX + x) * 3;
+                for (int ch = 0; ch < 3; ++ch) {
+                    out[ch] = std::max(out[ch], scale(a, color[ch]));
+                }
+            }
+        }
+    }
+
+    /*
+     * 放大彩色绘制函数
+     * 用buildScaled建立的放大图块，把第glyph个字形以color颜色绘制到从字符格 (cellX, cellY) 开始、
+     * factor x factor 个字符格大小的区域，合成方式同blitColor
+     */
+    void blitScaledColor(cv::Mat& frame, int cellX, int cellY, int factor, int glyph, const cv::Vec3b& color) const {
+        const int width = tileWidth * factor;
+        const int originX = cellX * cellWidth() - ASCIIVideoConstants::ATLAS_GLYPH_PADDING * factor;
+        const int x0 = std::max(columnBegin[glyph] * factor, -originX);
+        const int x1 = std::min(columnEnd[glyph] * factor, frame.cols - originX);
+        const uchar* tile = &scaledAlpha[factor][static_cast<size_t>(glyph) * width * tileHeight * factor];
+
+        for (int y = 0; y < tileHeight * factor; ++y) {
+            const uchar* src = tile + y * width;
+            uchar* dst = frame.ptr<uchar>(cellY * tileHeight + y);
+            for (int x = x0; x < x1; ++x) {
+                int a = src[x];
+                uchar* out = dst + (originX + x) * 3;
+                for (int ch = 0; ch < 3; ++ch) {
+                    out[ch] = std::max(out[ch], scale(a, color[ch]));
+                }
+            }
+        }
+    }
+
+    /*
+     * 灰度绘制函数
+     * 把第glyph个字形以level灰度绘制到CV_8UC1输出帧的字符格 (cellX, cellY)
+     * 单通道图块直接写入单通道输出，数据量只有彩色的三分之一
+     */
+    void blitMono(cv::Mat& frame, int cellX, int cellY, int glyph, uchar level) const {
+        int x0, x1;
+        if (!columnRange(frame.cols, cellX, glyph, x0, x1)) {
+            return;
+        }
+        const int originX = cellX * cellWidth() - ASCIIVideoConstants::ATLAS_GLYPH_PADDING;
+        const uchar* tile = &alpha[static_cast<size_t>(glyph) * tileWidth * tileHeight];
+
+        for (int y = 0; y < tileHeight; ++y) {
+            const uchar* src = tile + y * tileWidth;
+            uchar* dst = frame.ptr<uchar>(cellY * tileHeight + y) + originX + x0;
+            for (int x = x0; x < x1; ++x, ++dst) {
+                *dst = std::max(*dst, scale(src[x], level));
+            }
+        }
+    }
+
+    /*
+     * 混合绘制函数
+     * 把第glyph个字形以color颜色按透明度混合到已有背景上（CV_8UC3）
+     * 每个像素：输出 = 原值 + (颜色 - 原值) * 透明度 / 255
+     */
+    void blitBlend(cv::Mat& frame, int cellX, int cellY, int glyph, const cv::Vec3b& color) const {
+        int x0, x1;
+        if (!columnRange(frame.cols, cellX, glyph, x0, x1)) {
+            return;
+        }
+        const int originX = cellX * cellWidth() - ASCIIVideoConstants::ATLAS_GLYPH_PADDING;
+        const uchar* tile = &alpha[static_cast<size_t>(glyph) * tileWidth * tileHeight];
+
+        for (int y = 0; y < tileHeight; ++y) {
+            const uchar* src = tile + y * tileWidth;
+            uchar* dst = frame.ptr<uchar>(cellY * tileHeight + y);
+            for (int x = x0; x < x1; ++x) {
+                int a = src[x];
+                uchar* out = dst + (originX + x) * 3;
+                for (int ch = 0; ch < 3; ++ch) {
+                    out[ch] = static_cast<uchar>(scale(255 - a, out[ch]) + scale(a, color[ch]));
+                }
+            }
+        }
+    }
+
+private:
+    void setSpan(int glyphSpan) {
+        span = glyphSpan;
+        scaledAlpha.clear();
+        tileWidth = span * ASCIIVideoConstants::ASCII_CHAR_WIDTH + 2 * ASCIIVideoConstants::ATLAS_GLYPH_PADDING;
+    }
+
+    // 在图块中填充矩形（图块坐标，左闭右开）
+    void fillTile(uchar* tile, int x0, int y0, int x1, int y1, uchar value) const {
+        for (int y = std::max(0, y0); y < std::min(tileHeight, y1); ++y) {
+            for (int x = std::max(0, x0); x < std::min(tileWidth, x1); ++x) {
+                tile[y * tileWidth + x] = value;
+            }
+        }
+    }
+
+    /*
+     * 程序绘制字形函数
+     * 方块元素（U+2580-U+259F）按比例填充字符格，阴影（U+2591-U+2593）为均匀透明度，
+     * 制表符（U+2500-U+257F中的横竖线、拐角、T形和十字，细线和粗线）由中心向四边延伸；
+     * 所有笔画都对齐到字符格边界，相邻字符格拼接时没有缝隙，也不伸进留白
+     *
+     * 返回值：
+     *   bool: 不是程序绘制的字符时返回false
+     */
+    bool drawProceduralGlyph(char32_t cp, uchar* tile) const {
+        const int x0 = ASCIIVideoConstants::ATLAS_GLYPH_PADDING;   // 字符格左边界（图块坐标）
+        const int w = cellWidth();
+        const int h = tileHeight;
+
+        if (cp == 0x2588) {                                    // 全块
+            fillTile(tile, x0, 0, x0 + w, h, 255);
+        } else if (cp == 0x2580) {                             // 上半块
+            fillTile(tile, x0, 0, x0 + w, h / 2, 255);
+        } else if (cp >= 0x2581 && cp <= 0x2587) {             // 下方 1/8 - 7/8
+            fillTile(tile, x0, h - h * static_cast<int>(cp - 0x2580) / 8, x0 + w, h, 255);
+        } else if (cp >= 0x2589 && cp <= 0x258F) {             // 左侧 7/8 - 1/8
+            fillTile(tile, x0, 0, x0 + w * static_cast<int>(0x2590 - cp) / 8, h, 255);
+        } else if (cp == 0x2590) {                             // 右半块
+            fillTile(tile, x0 + w / 2, 0, x0 + w, h, 255);
+        } else if (cp >= 0x2591 && cp <= 0x2593) {             // 浅、中、深阴影
+            fillTile(tile, x0, 0, x0 + w, h, static_cast<uchar>(64 * (cp - 0x2590)));
+        } else if (cp == 0x2594) {                             // 上方 1/8
+            fillTile(tile, x0, 0, x0 + w, h / 8, 255);
+        } else if (cp == 0x2595) {                             // 右侧 1/8
+            fillTile(tile, x0 + w - w / 8, 0, x0 + w, h, 255);
+        } else if (cp >= 0x2596 && cp <= 0x259F) {             // 四分块：位0左上、1右上、2左下、3右下
+            static const uchar quadrants[10] = {4, 8, 1, 13, 9, 7, 11, 2, 6, 14};
+            uchar mask = quadrants[cp - 0x2596];
+            for (int q = 0; q < 4; ++q) {
+                if (mask & (1 << q)) {
+                    int qx = x0 + (q & 1) * (w / 2);
+                    int qy = (q >> 1) * (h / 2);
+                    fillTile(tile, qx, qy, qx + w / 2, qy + h / 2, 255);
+                }
+            }
+        } else {
+            // 制表符：位0向左、1向右、2向上、3向下
+            struct BoxGlyph { char32_t cp; uchar arms; int thickness; };
+            static const BoxGlyph boxGlyphs[] = {
+                {0x2500, 3, 1}, {0x2502, 12, 1}, {0x250C, 10, 1}, {0x2510, 9, 1}, {0x2514, 6, 1}, {0x2518, 5, 1},
+                {0x251C, 14, 1}, {0x2524, 13, 1}, {0x252C, 11, 1}, {0x2534, 7, 1}, {0x253C, 15, 1},
+                {0x2574, 1, 1}, {0x2575, 4, 1}, {0x2576, 2, 1}, {0x2577, 8, 1},
+                {0x2501, 3, 2}, {0x2503, 12, 2}, {0x250F, 10, 2}, {0x2513, 9, 2}, {0x2517, 6, 2}, {0x251B, 5, 2},
+                {0x2523, 14, 2}, {0x252B, 13, 2}, {0x2533, 11, 2}, {0x253B, 7, 2}, {0x254B, 15, 2},
+                {0x2578, 1, 2}, {0x2579, 4, 2}, {0x257A, 2, 2}, {0x257B, 8, 2},
+            };
+            const BoxGlyph* box = nullptr;
+            for (const BoxGlyph& candidate : boxGlyphs) {
+                if (candidate.cp == cp) {
+                    box = &candidate;
+                }
+            }
+            if (!box) {
+                return false;
+            }
+            int cx0 = x0 + (w - box->thickness) / 2, cx1 = cx0 + box->thickness;
+            int cy0 = (h - box->thickness) / 2, cy1 = cy0 + box->thickness;
+            if (box->arms & 1) fillTile(tile, x0, cy0, cx1, cy1, 255);
+            if (box->arms & 2) fillTile(tile, cx0, cy0, x0 + w, cy1, 255);
+            if (box->arms & 4) fillTile(tile, cx0, 0, cx1, cy1, 255);
+            if (box->arms & 8) fillTile(tile, cx0, cy0, cx1, h, 255);
+        }
+        return true;
+    }
+
+    // 记录每个字形的非空列范围，绘制时跳过空列（空格字符不产生任何写入）
+    void recordColumnRanges() {
+        const int count = static_cast<int>(alpha.size() / (static_cast<size_t>(tileWidth) * tileHeight));
+        columnBegin.assign(count, tileWidth);
+        columnEnd.assign(count, 0);
+        for (int i = 0; i < count; ++i) {
+            const uchar* tile = &alpha[static_cast<size_t>(i) * tileWidth * tileHeight];
+            for (int y = 0; y < tileHeight; ++y) {
+                for (int x = 0; x < tileWidth; ++x) {
+                    if (tile[y * tileWidth + x]) {
+                        columnBegin[i] = std::min(columnBegin[i], x);
+                        columnEnd[i] = std::max(columnEnd[i], x + 1);
+                    }
+                }
+            }
+        }
+    }
+
+    // 缓存文件路径；找不到缓存目录时返回空字符串（不使用缓存）
+    static std::string cacheFilePath(uint64_t key) {
+        std::string dir;
+        if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+            dir = xdg;
+        } else if (const char* home = std::getenv("HOME")) {
+            dir = std::string(home) + "/.cache";
+        } else {
+            return "";
+        }
+        mkdir(dir.c_str(), 0755);
+        dir += "/miku";
+        mkdir(dir.c_str(), 0755);
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "/atlas-%016llx.bin", static_cast<unsigned long long>(key));
+        return dir + name;
+    }
+
+    // 缓存文件格式：标识、版本、图块宽高、字形数、键值，随后是全部透明度数据
+    bool loadCache(const std::string& path, uint64_t key, int count) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        uint32_t header[5];
+        uint64_t storedKey;
+        in.read(reinterpret_cast<char*>(header), sizeof(header));
+        in.read(reinterpret_cast<char*>(&storedKey), sizeof(storedKey));
+        if (!in || header[0] != ASCIIVideoConstants::ATLAS_CACHE_MAGIC ||
+            header[1] != ASCIIVideoConstants::ATLAS_CACHE_VERSION ||
+            static_cast<int>(header[2]) != tileWidth || static_cast<int>(header[3]) != tileHeight ||
+            static_cast<int>(header[4]) != count || storedKey != key) {
+            return false;
+        }
+        std::vector<uchar> data(static_cast<size_t>(count) * tileWidth * tileHeight);
+        in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!in) {
+            return false;
+        }
+        alpha.swap(data);
+        recordColumnRanges();
+        return true;
+    }
+
+    void saveCache(const std::string& path, uint64_t key) const {
+        // 先写入同一目录下的唯一临时文件，写完再rename覆盖正式路径：
+        // 并发任务同时写同一个缓存时，读者只会看到完整的旧文件或新文件
+        std::string tempPath = path + ".XXXXXX";
+        int fd = mkstemp(&tempPath[0]);
+        if (fd < 0) {
+            std::cerr << "警告: 无法写入字形图集缓存 " << path << std::endl;
+            return;
+        }
+        uint32_t header[5] = {ASCIIVideoConstants::ATLAS_CACHE_MAGIC, ASCIIVideoConstants::ATLAS_CACHE_VERSION,
+                              static_cast<uint32_t>(tileWidth), static_cast<uint32_t>(tileHeight),
+                              static_cast<uint32_t>(alpha.size() / (static_cast<size_t>(tileWidth) * tileHeight))};
+        std::string bytes(reinterpret_cast<const char*>(header), sizeof(header));
+        bytes.append(reinterpret_cast<const char*>(&key), sizeof(key));
+        bytes.append(reinterpret_cast<const char*>(alpha.data()), alpha.size());
+
+        size_t done = 0;
+        while (done < bytes.size()) {
+            ssize_t written = ::write(fd, bytes.data() + done, bytes.size() - done);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                break;
+            }
+            done += static_cast<size_t>(written);
+        }
+        bool ok = done == bytes.size();
+        ok = ::close(fd) == 0 && ok;
+        if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            ::unlink(tempPath.c_str());
+            std::cerr << "警告: 无法写入字形图集缓存 " << path << std::endl;
+        }
+    }
+
+#ifdef MIKU_WITH_FREETYPE
+    /*
+     * FreeType光栅化函数
+     * 每个字符渲染为8位抗锯齿位图，水平方向按字符宽度在字符格内居中，
+     * 垂直方向让字体的行高（上伸部到下伸部）在字符格内居中
+     */
+    bool rasterizeFont(const std::vector<char32_t>& charset, const std::string& fontPath, int pixelSize, bool bold) {
+        FT_Library library;
+        if (FT_Init_FreeType(&library) != 0) {
+            std::cerr << "错误: FreeType初始化失败" << std::endl;
+            return false;
+        }
+        FT_Face face;
+        if (FT_New_Face(library, fontPath.c_str(), 0, &face) != 0) {
+            std::cerr << "错误: 无法加载字体文件: " << fontPath << std::endl;
+            FT_Done_FreeType(library);
+            return false;
+        }
+
+        // 自动字号：从字符格高度开始递减，直到行高放得进字符格、字符宽度不超出留白
+        const int slotWidth = cellWidth();
+        const int pad = ASCIIVideoConstants::ATLAS_GLYPH_PADDING;
+        int size = pixelSize > 0 ? pixelSize : tileHeight;
+        for (;;) {
+            FT_Set_Pixel_Sizes(face, 0, static_cast<FT_UInt>(size));
+            const FT_Size_Metrics& metrics = face->size->metrics;
+            int lineHeight = static_cast<int>((metrics.ascender - metrics.descender) >> 6);
+            int advance = static_cast<int>(metrics.max_advance >> 6);
+            if (pixelSize > 0 || size <= 4 || (lineHeight <= tileHeight && advance <= slotWidth + pad)) {
+                break;
+            }
+            --size;
+        }
+        const int ascender = static_cast<int>(face->size->metrics.ascender >> 6);
+        const int descender = static_cast<int>(face->size->metrics.descender >> 6);
+        const int baseline = (tileHeight - (ascender - descender)) / 2 + ascender;
+
+        const int count = static_cast<int>(charset.size());
+        alpha.assign(static_cast<size_t>(count) * tileWidth * tileHeight, 0);
+        for (int i = 0; i < count; ++i) {
+            uchar* tile = &alpha[static_cast<size_t>(i) * tileWidth * tileHeight];
+            if (drawProceduralGlyph(charset[i], tile)) {
+                continue;
+            }
+            FT_UInt index = FT_Get_Char_Index(face, charset[i]);
+            if (index == 0 && charset[i] != ' ') {
+                std::cerr << "警告: 字体中没有字符 " << encodeUTF8(charset[i]) << std::endl;
+            }
+            if (FT_Load_Glyph(face, index, FT_LOAD_TARGET_NORMAL) != 0) {
+                continue;
+            }
+            FT_GlyphSlot slot = face->glyph;
+            if (bold && slot->format == FT_GLYPH_FORMAT_OUTLINE) {
+                FT_Outline_Embolden(&slot->outline, ASCIIVideoConstants::FONT_EMBOLDEN_STRENGTH);
+            }
+            if (FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL) != 0) {
+                continue;
+            }
+
+            // 轮廓字形渲染为8位灰度；点阵字体和内嵌点阵（bitmap strike）为每像素1位，按位展开为0/255；
+            // 其他格式（如彩色表情的BGRA）不支持
+            const FT_Bitmap& bitmap = slot->bitmap;
+            const bool monoBitmap = bitmap.pixel_mode == FT_PIXEL_MODE_MONO;
+            if (!monoBitmap && bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) {
+                std::cerr << "警告: 字符 " << encodeUTF8(charset[i]) << " 的字形格式不支持，跳过" << std::endl;
+                continue;
+            }
+            int advance = static_cast<int>(slot->advance.x >> 6);
+            int left = pad + (slotWidth - advance) / 2 + slot->bitmap_left;
+            int top = baseline - slot->bitmap_top;
+            for (int y = 0; y < static_cast<int>(bitmap.rows); ++y) {
+                int ty = top + y;
+                if (ty < 0 || ty >= tileHeight) {
+                    continue;
+                }
+                const uchar* src = bitmap.buffer + y * bitmap.pitch;
+                for (int x = 0; x < static_cast<int>(bitmap.width); ++x) {
+                    int tx = left + x;
+                    if (tx >= 0 && tx < tileWidth) {
+                        tile[ty * tileWidth + tx] = monoBitmap ? ((src[x >> 3] >> (7 - (x & 7))) & 1) * 255 : src[x];
+                    }
+                }
+            }
+        }
+
+        std::cout << "字形图集: " << fontPath << "，字号 " << size << " 像素" << (bold ? "，加粗" : "") << std::endl;
+        FT_Done_Face(face);
+        FT_Done_FreeType(library);
+        recordColumnRanges();
+        return true;
+    }
+#endif
+
+    // a * v / 255，四舍五入（整数运算）
+    static uchar scale(int a, int v) {
+        int product = a * v + 128;
+        return static_cast<uchar>((product + (product >> 8)) >> 8);
+    }
+
+    /*
+     * 计算字形需要写入的列范围（图块坐标），并裁掉超出输出帧左右边界的部分
+     * 返回值：没有需要写入的列时返回false
+     */
+    bool columnRange(int frameWidth, int cellX, int glyph, int& x0, int& x1) const {
+        const int originX = cellX * cellWidth() - ASCIIVideoConstants::ATLAS_GLYPH_PADDING;
+        x0 = std::max(columnBegin[glyph], -originX);
+        x1 = std::min(columnEnd[glyph], frameWidth - originX);
+        return x0 < x1;
+    }
+};
+
+/*
+ * SummedAreaTable类
+ * 每帧一次遍历建立三通道积分图（求和面积表），之后任意矩形区域的平均颜色都是O(1)
+ *
+ * 用途：
+ *   1. 非整数比例的网格：每个字符格直接按像素范围求平均，不依赖cv::resize的均匀划分
+ *   2. 兴趣区域网格：大小不同的字符格共用同一张表
+ *   3. 同一帧需要多种网格宽度时，只需建表一次
+ *
+ * 存储布局：(height+1) 行 x (width+1) 列 x 3 通道的uint32，首行首列为0
+ * 大分辨率下累加值可能超过uint32范围，但区域和按无符号数相减结果仍然正确
+ */
+class SummedAreaTable {
+private:
+    int width;                     // 源图像宽度
+    int height;                    // 源图像高度
+    size_t stride;                 // 每行元素数 = (width+1)*3
+    std::vector<uint32_t> table;   // 积分图数据，帧间复用，避免每帧分配内存
+    const uchar* outputLut;        // 线性光建表时，平均值经此表转回sRGB
+
+    /*
+     * 按行建表
+     * map: 像素值映射（恒等或sRGB->线性光），作为模板参数内联进循环
+     */
+    template <typename PixelMap>
+    void buildRows(const cv::Mat& bgr, PixelMap map) {
+        width = bgr.cols;
+        height = bgr.rows;
+        stride = static_cast<size_t>(width + 1) * 3;
+        table.resize(stride * (height + 1));
+        std::fill(table.begin(), table.begin() + stride, 0u);
+
+        for (int y = 0; y < height; ++y) {
+            const uchar* src = bgr.ptr<uchar>(y);
+            const uint32_t* prev = &table[stride * y];
+            uint32_t* cur = &table[stride * (y + 1)];
+
+            // 水平前缀和
+            uint32_t sumB = 0, sumG = 0, sumR = 0;
+            cur[0] = cur[1] = cur[2] = 0;
+            for (int x = 0; x < width; ++x) {
+                sumB += map(src[3 * x]);
+                sumG += map(src[3 * x + 1]);
+                sumR += map(src[3 * x + 2]);
+                cur[3 * x + 3] = sumB;
+                cur[3 * x + 4] = sumG;
+                cur[3 * x + 5] = sumR;
+            }
+
+            // 垂直累加（可向量化）
+            for (size_t i = 3; i < stride; ++i) {
+                cur[i] += prev[i];
+            }
+        }
+    }
+
+public:
+    SummedAreaTable() : width(0), height(0), stride(0), outputLut(nullptr) {}
+
+    /*
+     * 建表函数
+     * 参数：
+     *   bgr: CV_8UC3图像（可以是ROI视图）
+     *   linear: 非空时在建表过程中把像素经查找表转换为线性光再累加，
+     *           求平均时再转回sRGB；转换与建表在同一次遍历中完成
+     *
+     * 每行分两步：先求本行的水平前缀和（串行），再整行加上上一行的积分值；
+     * 第二步是连续的uint32数组相加，编译器在-O3 -march=native下会自动向量化
+     */
+    void build(const cv::Mat& bgr, const LinearLightLUT* linear = nullptr) {
+        outputLut = linear ? linear->toSRGB : nullptr;
+        if (linear) {
+            const uint16_t* lut = linear->toLinear;
+            buildRows(bgr, [lut](uchar v) { return static_cast<uint32_t>(lut[v]); });
+        } else {
+            buildRows(bgr, [](uchar v) { return static_cast<uint32_t>(v); });
+        }
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    /*
+     * 区域平均颜色函数
+     * 求 [x0, x1) x [y0, y1) 区域的平均颜色，调用者保证区域非空
+     */
+    cv::Vec3b cellMean(int x0, int y0, int x1, int y1) const {
+        const uint32_t* a = &table[stride * y0 + 3 * x0];
+        const uint32_t* b = &table[stride * y0 + 3 * x1];
+        const uint32_t* c = &table[stride * y1 + 3 * x0];
+        const uint32_t* d = &table[stride * y1 + 3 * x1];
+        uint32_t area = static_cast<uint32_t>((x1 - x0) * (y1 - y0));
+
+        cv::Vec3b mean;
+        for (int ch = 0; ch < 3; ++ch) {
+            uint32_t sum = d[ch] - b[ch] - c[ch] + a[ch];
+            uint32_t value = (sum + area / 2) / area;
+            mean[ch] = outputLut ? outputLut[value] : static_cast<uchar>(value);
+        }
+        return mean;
+    }
+
+    /*
+     * 网格平均函数
+     * 把源图像划分为 gridWidth x gridHeight 个字符格，每格求平均颜色
+     * 格子边界按整数比例取整，宽高比不必是整数倍；
+     * 输出与cv::resize(INTER_AREA)相同格式的CV_8UC3网格图像
+     */
+    void cellMeans(int gridWidth, int gridHeight, cv::Mat& grid) const {
+        grid.create(gridHeight, gridWidth, CV_8UC3);
+        for (int cy = 0; cy < gridHeight; ++cy) {
+            int y0 = cy * height / gridHeight;
+            int y1 = std::max(y0 + 1, (cy + 1) * height / gridHeight);
+            cv::Vec3b* out = grid.ptr<cv::Vec3b>(cy);
+            for (int cx = 0; cx < gridWidth; ++cx) {
+                int x0 = cx * width / gridWidth;
+                int x1 = std::max(x0 + 1, (cx + 1) * width / gridWidth);
+                out[cx] = cellMean(x0, y0, x1, y1);
+            }
+        }
+    }
+};
+
+/*
+ * AsyncFileWriter类
+ * 输出文件的异步写出器：图像序列的逐帧文件和字符网格文件的帧记录都经这里写盘
+ *
+ * 渲染线程从缓冲池取一块缓冲区，把编码结果直接写进去后提交，不等待磁盘；
+ * 专用写出线程一次取走所有待写请求，用io_uring一次系统调用提交整批写操作
+ * （未启用io_uring时逐个pwrite），写完后把缓冲区还回池中
+ *
+ * 缓冲池在打开时按帧大小预留容量，并整体注册为io_uring固定缓冲区：
+ * 编码结果没有超出预留容量时按固定缓冲区写出，内核不必每次重新映射页面，也没有额外拷贝
+ */
+class AsyncFileWriter {
+public:
+    // 缓冲区编号
+    using Buffer = int;
+
+private:
+    // 一个写请求：把整块缓冲区写到文件的指定位置
+    struct Request {
+        Buffer buffer;
+        int fd;                 // 目标文件；-1表示由写出线程按path创建
+        std::string path;       // 图像序列的帧文件路径
+        off_t offset;           // 写入位置
+        bool ok;                // 写出结果
+    };
+
+    std::vector<std::vector<uchar>> buffers;  // 缓冲池
+    std::vector<const uchar*> registered;     // 各缓冲区注册为固定缓冲区时的地址（未注册为nullptr）
+    std::vector<size_t> registeredBytes;      // 各缓冲区注册时的长度
+    std::vector<Buffer> freeBuffers;          // 空闲缓冲区
+    std::deque<Request> pending;              // 待写请求
+    std::mutex mutex;                         // 保护空闲列表、请求队列和状态
+    std::condition_variable cond;             // 有新请求或缓冲区被归还
+    bool stopping;                            // 请求写出线程写完剩余请求后退出
+    std::atomic<bool> failed;                 // 有写操作失败（写出线程和调用线程都会读写）
+    std::thread worker;                       // 写出线程
+
+    int appendFd;                 // 追加写入的文件（字符网格文件）
+    std::string appendPath;
+    off_t appendOffset;           // 下一个追加请求的写入位置
+
+    int filesWritten;             // 统计：创建的文件数
+    size_t bytesWritten;          // 统计：写出的字节数
+    int fixedWrites;              // 统计：按固定缓冲区提交的写操作数
+
+#ifdef MIKU_HAS_URING
+    io_uring ring;
+    bool ringReady;
+#endif
+
+public:
+    AsyncFileWriter()
+        : stopping(false), failed(false), appendFd(-1), appendOffset(0),
+          filesWritten(0), bytesWritten(0), fixedWrites(0) {
+#ifdef MIKU_HAS_URING
+        ringReady = false;
+#endif
+    }
+
+    ~AsyncFileWriter() {
+        finish();
+    }
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    bool isOpen() const { return worker.joinable(); }
+
+    /*
+     * 打开写出器函数
+     * 分配缓冲池、初始化io_uring并启动写出线程；已经打开时直接返回true
+     * （超出预留容量的缓冲区仍可使用，只是退回普通写操作）
+     *
+     * 参数：
+     *   bufferBytes: 每块缓冲区预留的容量（一帧编码结果的上限估计）
+     */
+    bool open(size_t bufferBytes) {
+        if (isOpen()) {
+            return true;
+        }
+        const int count = ASCIIVideoConstants::OUTPUT_BUFFER_COUNT;
+        buffers.assign(count, std::vector<uchar>());
+        registered.assign(count, nullptr);
+        registeredBytes.assign(count, 0);
+        freeBuffers.clear();
+        for (Buffer i = 0; i < count; ++i) {
+            buffers[i].reserve(bufferBytes);
+            freeBuffers.push_back(i);
+        }
+#ifdef MIKU_HAS_URING
+        if (io_uring_queue_init(count, &ring, 0) == 0) {
+            ringReady = true;
+            std::vector<iovec> iov(count);
+            for (int i = 0; i < count; ++i) {
+                iov[i].iov_base = buffers[i].data();
+                iov[i].iov_len = buffers[i].capacity();
+            }
+            // 注册需要锁定内存，超出RLIMIT_MEMLOCK时只是不使用固定缓冲区
+            if (io_uring_register_buffers(&ring, iov.data(), count) == 0) {
+                for (int i = 0; i < count; ++i) {
+                    registered[i] = buffers[i].data();
+                    registeredBytes[i] = iov[i].iov_len;
+                }
+            }
+        } else {
+            std::cerr << "警告: io_uring不可用，改用写出线程逐个写入" << std::endl;
+        }
+#endif
+        stopping = false;
+        worker = std::thread(&AsyncFileWriter::writeLoop, this);
+        return true;
+    }
+
+    /*
+     * 打开追加写入的文件（截断已有内容），之后用append按顺序写入
+     * 返回值：无法创建文件时返回false
+     */
+    bool openAppend(const std::string& path) {
+        appendFd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        appendPath = path;
+        appendOffset = 0;
+        return appendFd >= 0;
+    }
+
+    /*
+     * 取得一块空闲缓冲区（清空内容，保留容量）；全部在途时等待写出线程归还
+     */
+    std::vector<uchar>& acquire(Buffer& id) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this] { return !freeBuffers.empty(); });
+        id = freeBuffers.back();
+        freeBuffers.pop_back();
+        buffers[id].clear();
+        return buffers[id];
+    }
+
+    // 把缓冲区内容写成一个新文件（图像序列的一帧）
+    void writeFile(Buffer id, const std::string& path) {
+        submit({id, -1, path, 0, false});
+    }
+
+    // 把缓冲区内容追加到openAppend打开的文件
+    void append(Buffer id) {
+        off_t offset = appendOffset;
+        appendOffset += static_cast<off_t>(buffers[id].size());
+        submit({id, appendFd, std::string(), offset, false});
+    }
+
+    /*
+     * 结束写出函数
+     * 等待所有请求写完，关闭文件并输出统计
+     *
+     * 返回值：
+     *   bool: 所有写操作都成功时返回true
+     */
+    bool finish() {
+        if (!isOpen()) {
+            return !failed;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cond.notify_all();
+        worker.join();
+        if (appendFd >= 0) {
+            if (::close(appendFd) != 0) {
+                std::cerr << "写入失败: " << appendPath << std::endl;
+                failed = true;
+            }
+            filesWritten++;
+            appendFd = -1;
+        }
+        const char* method = "写出线程";
+#ifdef MIKU_HAS_URING
+        if (ringReady) {
+            io_uring_queue_exit(&ring);
+            ringReady = false;
+            method = "io_uring";
+        }
+#endif
+        std::cout << "异步写出: " << filesWritten << " 个文件, "
+                  << std::fixed << std::setprecision(1) << bytesWritten / (1024.0 * 1024.0) << " MB ("
+                  << method << (fixedWrites > 0 ? "，固定缓冲区写 " + std::to_string(fixedWrites) + " 次" : "")
+                  << ")" << std::endl;
+        return !failed;
+    }
+
+private:
+    void submit(Request request) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(std::move(request));
+        }
+        cond.notify_all();
+    }
+
+    /*
+     * 写出线程主循环
+     * 取走全部待写请求 -> 创建图像序列的帧文件 -> 整批提交写操作 -> 关闭文件、归还缓冲区
+     * 收到结束请求后写完剩余请求再退出
+     */
+    void writeLoop() {
+        std::vector<Request> batch;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [this] { return stopping || !pending.empty(); });
+                if (pending.empty()) {
+                    return;
+                }
+                batch.assign(std::make_move_iterator(pending.begin()), std::make_move_iterator(pending.end()));
+                pending.clear();
+            }
+
+            for (Request& request : batch) {
+                if (request.fd < 0) {
+                    request.fd = ::open(request.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+                }
+            }
+
+            bool submitted = false;
+#ifdef MIKU_HAS_URING
+            submitted = ringReady && submitBatch(batch);
+#endif
+            if (!submitted) {
+                for (Request& request : batch) {
+                    request.ok = request.fd >= 0 && writeRemaining(request, 0);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            for (Request& request : batch) {
+                if (request.fd >= 0 && request.fd != appendFd) {
+                    request.ok = ::close(request.fd) == 0 && request.ok;
+                    filesWritten++;
+                }
+                if (request.ok) {
+                    bytesWritten += buffers[request.buffer].size();
+                } else if (!failed) {
+                    std::cerr << "写入失败: " << (request.path.empty() ? appendPath : request.path) << std::endl;
+                    failed = true;
+                }
+                freeBuffers.push_back(request.buffer);
+            }
+            cond.notify_all();
+        }
+    }
+
+    // 从done字节处用pwrite写完剩余部分（回退路径，以及io_uring短写后的补写）
+    bool writeRemaining(const Request& request, size_t done) {
+        const std::vector<uchar>& data = buffers[request.buffer];
+        while (done < data.size()) {
+            ssize_t n = ::pwrite(request.fd, data.data() + done, data.size() - done,
+                                 request.offset + static_cast<off_t>(done));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            done += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+#ifdef MIKU_HAS_URING
+    /*
+     * 用io_uring整批提交写操作并等待全部完成
+     * 一批请求数不超过缓冲区数，也就不超过提交队列深度
+     *
+     * 返回值：有请求无法提交时等已提交的请求完成后关闭io_uring并返回false，由调用者改用pwrite
+     */
+    bool submitBatch(std::vector<Request>& batch) {
+        int queued = 0;
+        for (Request& request : batch) {
+            if (request.fd < 0) {
+                continue;
+            }
+            io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+            const std::vector<uchar>& data = buffers[request.buffer];
+            // 缓冲区没有重新分配、且数据不超出注册的范围时才能按固定缓冲区写
+            if (data.data() == registered[request.buffer] && data.size() <= registeredBytes[request.buffer]) {
+                io_uring_prep_write_fixed(sqe, request.fd, data.data(), static_cast<unsigned>(data.size()),
+                                          request.offset, request.buffer);
+                fixedWrites++;
+            } else {
+                io_uring_prep_write(sqe, request.fd, data.data(), static_cast<unsigned>(data.size()), request.offset);
+            }
+            io_uring_sqe_set_data(sqe, &request);
+            queued++;
+        }
+        if (queued == 0) {
+            return true;
+        }
+        // io_uring_submit可能只提交一部分，循环提交剩余的请求
+        int submitted = 0;
+        while (submitted < queued) {
+            int ret = io_uring_submit(&ring);
+            if (ret == -EINTR) {
+                continue;
+            }
+            if (ret <= 0) {
+                break;
+            }
+            submitted += ret;
+        }
+        // 只等待实际提交的请求完成
+        for (int reaped = 0; reaped < submitted;) {
+            io_uring_cqe* cqe = nullptr;
+            int ret = io_uring_wait_cqe(&ring, &cqe);
+            if (ret == -EINTR) {
+                continue;
+            }
+            if (ret < 0) {
+                failed = true;
+                break;
+            }
+            Request* request = static_cast<Request*>(io_uring_cqe_get_data(cqe));
+            int result = cqe->res;
+            io_uring_cqe_seen(&ring, cqe);
+            // 短写时用pwrite补齐剩余部分
+            request->ok = result >= 0 && writeRemaining(*request, static_cast<size_t>(result));
+            reaped++;
+        }
+        if (submitted < queued) {
+            // 剩余请求无法提交：关闭io_uring，由调用者用pwrite重写整批（重写同一位置不影响结果）
+            std::cerr << "警告: io_uring提交失败，改用写出线程逐个写入" << std::endl;
+            io_uring_queue_exit(&ring);
+            ringReady = false;
+            return false;
+        }
+        return true;
+    }
+#endif
+};
+
+/*
+ * SegmentedOutput类
+ * 分段输出：把ASCII视频切成若干秒一段的MPEG-TS分段文件，并随转换进度更新HLS播放列表（.m3u8）
+ *
+ * 每个分段由独立的编码线程写出：渲染线程把帧放入当前分段的队列后继续渲染，
+ * 分段写满后关闭其队列、开始下一段，前一段的编码线程排空队列后收尾，
+ * 多个分段的编码因此可以并行进行。分段完成顺序可能与编号不同，
+ * 播放列表只列出从第一段开始连续完成的分段，下游播放器在转换开始几秒后即可开始播放
+ *
+ * 所有分段队列共享一个内存预算，超出时渲染线程等待编码线程消费
+ */
+class SegmentedOutput {
+private:
+    // 一个分段：编码线程、帧队列和完成状态
+    struct Segment {
+        int index = 0;
+        std::string path;                       // 分段文件路径
+        std::unique_ptr<cv::VideoWriter> writer;
+        std::deque<cv::Mat> frames;             // 待编码的帧
+        int frameCount = 0;                     // 已放入的帧数
+        bool closed = false;                    // 不会再有新帧
+        bool done = false;                      // 编码线程已结束
+        bool ok = false;                        // 分段写出成功
+        std::thread worker;
+    };
+
+    std::string playlistPath;
+    std::string segmentBase;        // 分段文件路径前缀（播放列表路径去掉扩展名）
+    double fps;
+    cv::Size frameSize;
+    bool isColor;
+    int fourcc;                     // 第一段选定的编码器，后续分段沿用
+    int framesPerSegment;
+    int maxQueuedFrames;            // 所有分段队列的帧数上限（由内存预算换算）
+
+    std::vector<std::unique_ptr<Segment>> segments;
+    Segment* current;               // 正在接收帧的分段
+    int queuedFrames;               // 所有队列中的帧数
+    int activeEncoders;             // 尚未结束的编码线程数
+    int publishedSegments;          // 已写入播放列表的分段数
+    std::mutex mutex;               // 保护分段列表、队列和计数
+    std::condition_variable cond;
+
+public:
+    SegmentedOutput()
+        : fps(0.0), isColor(true), fourcc(0), framesPerSegment(0), maxQueuedFrames(0),
+          current(nullptr), queuedFrames(0), activeEncoders(0), publishedSegments(0) {}
+
+    ~SegmentedOutput() {
+        finish();
+    }
+
+    SegmentedOutput(const SegmentedOutput&) = delete;
+    SegmentedOutput& operator=(const SegmentedOutput&) = delete;
+
+    bool isOpen() const { return !playlistPath.empty(); }
+
+    // 第index个分段的文件路径
+    std::string segmentPath(int index) const {
+        char suffix[32];
+        std::snprintf(suffix, sizeof(suffix), "_%05d.ts", index);
+        return segmentBase + suffix;
+    }
+
+    /*
+     * 打开分段输出函数
+     *
+     * 参数：
+     *   playlist: 播放列表路径（.m3u8）
+     *   firstWriter: 已用选定编码器打开的第一段写入器（路径为segmentPath(0)）
+     *   codec: 选定编码器的fourcc
+     *   segmentSeconds: 每段时长（秒）
+     */
+    void open(const std::string& playlist, std::unique_ptr<cv::VideoWriter> firstWriter, int codec,
+              double outputFps, cv::Size size, bool color, double segmentSeconds) {
+        playlistPath = playlist;
+        segmentBase = playlist.substr(0, playlist.size() - 5);
+        fps = outputFps;
+        frameSize = size;
+        isColor = color;
+        fourcc = codec;
+        framesPerSegment = std::max(1, static_cast<int>(std::lround(segmentSeconds * fps)));
+        const size_t frameBytes = static_cast<size_t>(size.area()) * (color ? 3 : 1);
+        maxQueuedFrames = std::max(2, static_cast<int>((static_cast<size_t>(ASCIIVideoConstants::SEGMENT_BUFFER_MB) << 20) / frameBytes));
+        publishPlaylist(false);
+        startSegment(std::move(firstWriter));
+    }
+
+    /*
+     * 写入一帧函数（渲染线程调用）
+     * 当前分段写满时先切换到下一段；帧被拷贝进队列，调用方可以继续复用自己的图像
+     */
+    void write(const cv::Mat& frame) {
+        if (current->frameCount == framesPerSegment) {
+            startSegment(nullptr);
+        }
+        cv::Mat copy = frame.clone();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] { return queuedFrames < maxQueuedFrames; });
+            current->frames.push_back(std::move(copy));
+            current->frameCount++;
+            queuedFrames++;
+        }
+        cond.notify_all();
+    }
+
+    /*
+     * 结束分段输出函数
+     * 关闭最后一段，等待全部编码线程结束，在播放列表末尾写入结束标记
+     *
+     * 返回值：
+     *   bool: 所有分段都写出成功时返回true
+     */
+    bool finish() {
+        if (!isOpen()) {
+            return true;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current->closed = true;
+        }
+        cond.notify_all();
+        bool ok = true;
+        for (auto& segment : segments) {
+            segment->worker.join();
+            ok = ok && segment->ok;
+        }
+        if (ok) {
+            publishPlaylist(true);
+            std::cout << "分段输出: " << segments.size() << " 段, 播放列表 " << playlistPath << std::endl;
+        } else {
+            std::cerr << "分段写出失败，播放列表只包含之前完成的分段: " << playlistPath << std::endl;
+        }
+        playlistPath.clear();
+        segments.clear();
+        current = nullptr;
+        return ok;
+    }
+
+private:
+    /*
+     * 开始新分段函数
+     * 关闭当前分段的队列；并行编码的分段数达到上限时等待最早的分段结束
+     */
+    void startSegment(std::unique_ptr<cv::VideoWriter> writer) {
+        auto segment = std::make_unique<Segment>();
+        segment->index = static_cast<int>(segments.size());
+        segment->path = segmentPath(segment->index);
+        segment->writer = std::move(writer);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (current) {
+                current->closed = true;
+                cond.notify_all();
+            }
+            cond.wait(lock, [this] { return activeEncoders < ASCIIVideoConstants::MAX_SEGMENT_ENCODERS; });
+            activeEncoders++;
+            current = segment.get();
+            segments.push_back(std::move(segment));
+        }
+        current->worker = std::thread(&SegmentedOutput::encodeLoop, this, current);
+    }
+
+    /*
+     * 分段编码线程主循环
+     * 打开分段文件（第一段已由调用方打开）-> 逐帧编码直到队列关闭且排空 -> 收尾并更新播放列表
+     */
+    void encodeLoop(Segment* segment) {
+        if (!segment->writer) {
+            segment->writer = std::make_unique<cv::VideoWriter>();
+            segment->writer->open(segment->path, fourcc, fps, frameSize, isColor);
+        }
+        const bool opened = segment->writer->isOpened();
+        while (true) {
+            cv::Mat frame;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [segment] { return !segment->frames.empty() || segment->closed; });
+                if (segment->frames.empty()) {
+                    break;
+                }
+                frame = std::move(segment->frames.front());
+                segment->frames.pop_front();
+                queuedFrames--;
+            }
+            cond.notify_all();
+            if (opened) {
+                segment->writer->write(frame);
+            }
+        }
+        segment->writer->release();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        segment->done = true;
+        segment->ok = opened;
+        if (!opened) {
+            std::cerr << "无法创建分段文件: " << segment->path << std::endl;
+        }
+        activeEncoders--;
+        publishPlaylist(false);
+        cond.notify_all();
+    }
+
+    /*
+     * 更新播放列表函数（持有锁时调用）
+     * 列出从第一段开始连续完成的分段；先写临时文件再改名，播放器不会读到写了一半的列表
+     */
+    void publishPlaylist(bool ended) {
+        int ready = 0;
+        while (ready < static_cast<int>(segments.size()) && segments[ready]->done && segments[ready]->ok) {
+            ready++;
+        }
+        if (!ended && ready == publishedSegments && ready > 0) {
+            return;
+        }
+
+        std::string temporary = playlistPath + ".tmp";
+        std::ofstream out(temporary, std::ios::trunc);
+        out << "#EXTM3U\n#EXT-X-VERSION:3\n";
+        out << "#EXT-X-TARGETDURATION:" << static_cast<int>(std::ceil(framesPerSegment / fps)) << "\n";
+        out << "#EXT-X-MEDIA-SEQUENCE:0\n#EXT-X-PLAYLIST-TYPE:EVENT\n";
+        for (int i = 0; i < ready; ++i) {
+            const std::string& path = segments[i]->path;
+            size_t slash = path.find_last_of('/');
+            // 每个分段由新的写入器编码，时间戳都从0开始，分段之间标记为不连续
+            if (i > 0) {
+                out << "#EXT-X-DISCONTINUITY\n";
+            }
+            out << "#EXTINF:" << std::fixed << std::setprecision(3) << segments[i]->frameCount / fps << ",\n"
+                << (slash == std::string::npos ? path : path.substr(slash + 1)) << "\n";
+        }
+        if (ended) {
+            out << "#EXT-X-ENDLIST\n";
+        }
+        out.close();
+        if (out) {
+            std::rename(temporary.c_str(), playlistPath.c_str());
+        }
+        publishedSegments = ready;
+    }
+};
+
+/*
+ * GifWriter类
+ * 动画GIF写出器：固定全局调色板 + 查找表量化 + 帧间差异矩形 + LZW编码
+ *
+ * ASCII帧的颜色来自少量字符格颜色与黑色背景的混合，用一个全局调色板即可：
+ * 彩色为 6x7x6 的RGB立方体（绿色多一级，人眼对绿色更敏感），灰度为255级灰阶；
+ * 每个像素按高5位查一次32K项的查找表得到调色板编号（表项为ΔE最近的调色板颜色），不需要逐帧中值切分。
+ * 每帧只编码与上一帧不同的最小矩形，矩形内未变化的像素写成透明色，
+ * LZW对大片透明像素的压缩率很高；与上一帧完全相同的帧不写入，只延长上一帧的显示时间
+ */
+class GifWriter {
+private:
+    std::ofstream file;
+    int width;
+    int height;
+    bool mono;
+    int frameStep;                       // 每隔几个输入帧写一帧（GIF的帧间隔最小约为2厘秒）
+    double framesPerCs;                  // 写入帧率（帧/厘秒）
+    int inputFrames;                     // 收到的输入帧数
+    int writtenFrames;                   // 按时间轴推进的写入帧数（含合并到上一帧的重复帧）
+    int encodedFrames;                   // 实际编码的帧数
+    std::vector<uint8_t> paletteLUT;     // RGB555（或8位灰度）-> 调色板编号
+    std::vector<uint8_t> indices;        // 当前帧的调色板编号
+    std::vector<uint8_t> previous;       // 上一帧的调色板编号
+    std::vector<uint8_t> rectPixels;     // 差异矩形内待编码的像素
+    std::streampos lastDelayPosition;    // 上一帧图形控制扩展中延时字段的位置
+    int lastDelay;                       // 上一帧的延时（厘秒）
+
+    // LZW编码状态：字典的开放寻址哈希表（键为 前缀码<<8 | 像素），输出位缓冲和数据子块
+    std::vector<int32_t> dictKeys;
+    std::vector<int16_t> dictCodes;
+    uint32_t bitBuffer;
+    int bitCount;
+    std::vector<uint8_t> block;
+
+    static constexpr uint8_t TRANSPARENT_INDEX = 255;
+    static constexpr int DICT_SIZE = 8192;
+
+public:
+    GifWriter()
+        : width(0), height(0), mono(false), frameStep(1), framesPerCs(0.0), inputFrames(0),
+          writtenFrames(0), encodedFrames(0), lastDelay(0), bitBuffer(0), bitCount(0) {}
+
+    bool isOpen() const { return file.is_open(); }
+
+    /*
+     * 打开GIF文件函数
+     * 写入文件头、全局调色板和循环播放扩展，建立颜色查找表
+     */
+    bool open(const std::string& path, double fps, cv::Size frameSize, bool grayscale) {
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file || frameSize.width > 65535 || frameSize.height > 65535) {
+            std::cerr << "无法创建GIF文件: " << path << std::endl;
+            file.close();
+            return false;
+        }
+        width = frameSize.width;
+        height = frameSize.height;
+        mono = grayscale;
+        frameStep = std::max(1, static_cast<int>(std::ceil(fps / ASCIIVideoConstants::GIF_MAX_FPS)));
+        framesPerCs = fps / frameStep / 100.0;
+        inputFrames = writtenFrames = encodedFrames = 0;
+
+        // 全局调色板：最后一项保留为透明色
+        std::vector<uint8_t> palette(256 * 3, 0);
+        if (mono) {
+            for (int i = 0; i < 255; ++i) {
+                palette[i * 3] = palette[i * 3 + 1] = palette[i * 3 + 2] = static_cast<uint8_t>(i * 255 / 254);
+            }
+            paletteLUT.resize(256);
+            for (int v = 0; v < 256; ++v) {
+                paletteLUT[v] = static_cast<uint8_t>((v * 254 + 127) / 255);
+            }
+        } else {
+            for (int r = 0; r < 6; ++r) {
+                for (int g = 0; g < 7; ++g) {
+                    for (int b = 0; b < 6; ++b) {
+                        int i = (r * 7 + g) * 6 + b;
+                        palette[i * 3] = static_cast<uint8_t>(r * 255 / 5);
+                        palette[i * 3 + 1] = static_cast<uint8_t>(g * 255 / 6);
+                        palette[i * 3 + 2] = static_cast<uint8_t>(b * 255 / 5);
+                    }
+                }
+            }
+
+            // 每个5位分量区间的中点取ΔE（Lab距离）最近的调色板颜色，而不是逐通道取最近的立方体级别：
+            // 全部32K个区间的平均ΔE由10.6降到8.8，最大ΔE由33降到18；
+            // 建表约800万次整数距离比较，只在打开文件时进行一次，每像素仍只查一次表
+            const LabColorLUT& lab = LabColorLUT::instance();
+            const int cubeColors = 6 * 7 * 6;
+            std::vector<int> paletteLab(cubeColors * 3);
+            for (int i = 0; i < cubeColors; ++i) {
+                lab.toLab(cv::Vec3b(palette[i * 3 + 2], palette[i * 3 + 1], palette[i * 3]), &paletteLab[i * 3]);
+            }
+            paletteLUT.resize(32768);
+            for (int key = 0; key < 32768; ++key) {
+                const cv::Vec3b bgr(static_cast<uint8_t>((key & 31) * 8 + 4), static_cast<uint8_t>(((key >> 5) & 31) * 8 + 4),
+                                    static_cast<uint8_t>(((key >> 10) & 31) * 8 + 4));
+                int color[3];
+                lab.toLab(bgr, color);
+                int best = 0;
+                int bestDistance = LabColorLUT::distanceSquared(color, &paletteLab[0]);
+                for (int i = 1; i < cubeColors && bestDistance > 0; ++i) {
+                    int distance = LabColorLUT::distanceSquared(color, &paletteLab[i * 3]);
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = i;
+                    }
+                }
+                paletteLUT[key] = static_cast<uint8_t>(best);
+            }
+        }
+
+        // 文件头和逻辑屏幕描述：全局调色板256项
+        file.write("GIF89a", 6);
+        writeLE(file, static_cast<uint32_t>(width), 2);
+        writeLE(file, static_cast<uint32_t>(height), 2);
+        file.put(static_cast<char>(0xF7));
+        file.put(0);
+        file.put(0);
+        file.write(reinterpret_cast<const char*>(palette.data()), static_cast<std::streamsize>(palette.size()));
+
+        // NETSCAPE2.0 扩展：无限循环播放
+        file.write("\x21\xFF\x0BNETSCAPE2.0\x03\x01\x00\x00\x00", 19);
+
+        indices.assign(static_cast<size_t>(width) * height, 0);
+        previous.clear();
+        dictKeys.assign(DICT_SIZE, -1);
+        dictCodes.assign(DICT_SIZE, 0);
+        std::cout << "输出GIF: " << fps / frameStep << "fps"
+                  << (frameStep > 1 ? "（每" + std::to_string(frameStep) + "帧取1帧）" : "") << std::endl;
+        return static_cast<bool>(file);
+    }
+
+    /*
+     * 写入一帧函数
+     * 量化 -> 与上一帧比较求差异矩形 -> 相同则延长上一帧，否则编码差异矩形
+     */
+    void write(const cv::Mat& frame) {
+        if (inputFrames++ % frameStep != 0) {
+            return;
+        }
+        // 本帧的显示时长按累计时间取整，长时间播放不漂移
+        int delay = static_cast<int>(std::lround((writtenFrames + 1) / framesPerCs) -
+                                     std::lround(writtenFrames / framesPerCs));
+        writtenFrames++;
+
+        // 量化：每像素一次查表
+        for (int y = 0; y < height; ++y) {
+            const uint8_t* src = frame.ptr<uint8_t>(y);
+            uint8_t* dst = indices.data() + static_cast<size_t>(y) * width;
+            if (mono) {
+                for (int x = 0; x < width; ++x) {
+                    dst[x] = paletteLUT[src[x]];
+                }
+            } else {
+                for (int x = 0; x < width; ++x) {
+                    const uint8_t* p = src + x * 3;  // BGR
+                    dst[x] = paletteLUT[((p[2] >> 3) << 10) | ((p[1] >> 3) << 5) | (p[0] >> 3)];
+                }
+            }
+        }
+
+        // 差异矩形：首帧为整幅画面
+        int x0 = 0, y0 = 0, x1 = width, y1 = height;
+        const bool first = previous.empty();
+        if (!first) {
+            x0 = width; y0 = height; x1 = 0; y1 = 0;
+            for (int y = 0; y < height; ++y) {
+                const uint8_t* now = indices.data() + static_cast<size_t>(y) * width;
+                const uint8_t* before = previous.data() + static_cast<size_t>(y) * width;
+                if (std::memcmp(now, before, width) == 0) {
+                    continue;
+                }
+                int left = 0;
+                while (now[left] == before[left]) {
+                    left++;
+                }
+                int right = width;
+                while (now[right - 1] == before[right - 1]) {
+                    right--;
+                }
+                x0 = std::min(x0, left);
+                x1 = std::max(x1, right);
+                y0 = std::min(y0, y);
+                y1 = y + 1;
+            }
+            if (x1 <= x0) {
+                // 与上一帧相同：回写上一帧的延时字段
+                lastDelay = std::min(65535, lastDelay + delay);
+                std::streampos end = file.tellp();
+                file.seekp(lastDelayPosition);
+                writeLE(file, static_cast<uint32_t>(lastDelay), 2);
+                file.seekp(end);
+                return;
+            }
+        }
+
+        // 图形控制扩展：保留上一帧（处置方式1），非首帧启用透明色
+        file.write("\x21\xF9\x04", 3);
+        file.put(static_cast<char>(first ? 0x04 : 0x05));
+        lastDelayPosition = file.tellp();
+        lastDelay = delay;
+        writeLE(file, static_cast<uint32_t>(delay), 2);
+        file.put(static_cast<char>(TRANSPARENT_INDEX));
+        file.put(0);
+
+        // 图像描述：差异矩形，使用全局调色板
+        file.put(0x2C);
+        writeLE(file, static_cast<uint32_t>(x0), 2);
+        writeLE(file, static_cast<uint32_t>(y0), 2);
+        writeLE(file, static_cast<uint32_t>(x1 - x0), 2);
+        writeLE(file, static_cast<uint32_t>(y1 - y0), 2);
+        file.put(0);
+
+        // 矩形内未变化的像素写成透明色
+        rectPixels.clear();
+        for (int y = y0; y < y1; ++y) {
+            const uint8_t* now = indices.data() + static_cast<size_t>(y) * width;
+            const uint8_t* before = first ? nullptr : previous.data() + static_cast<size_t>(y) * width;
+            for (int x = x0; x < x1; ++x) {
+                rectPixels.push_back(before && now[x] == before[x] ? TRANSPARENT_INDEX : now[x]);
+            }
+        }
+        encodeLZW(rectPixels);
+        previous.swap(indices);
+        if (indices.empty()) {
+            indices.assign(static_cast<size_t>(width) * height, 0);
+        }
+        encodedFrames++;
+    }
+
+    /*
+     * 结束写出函数
+     * 写入文件结束标记并关闭文件
+     *
+     * 返回值：
+     *   bool: 文件写入成功返回true
+     */
+    bool finish() {
+        if (!isOpen()) {
+            return true;
+        }
+        file.put(0x3B);
+        file.close();
+        std::cout << "GIF: 编码 " << encodedFrames << " 帧, 合并重复帧 " << writtenFrames - encodedFrames << " 帧" << std::endl;
+        return static_cast<bool>(file);
+    }
+
+private:
+    // 按LSB优先把一个编码追加到位缓冲，满一个字节就放入数据子块
+    void emitCode(int code, int codeSize) {
+        bitBuffer |= static_cast<uint32_t>(code) << bitCount;
+        bitCount += codeSize;
+        while (bitCount >= 8) {
+            pushByte(static_cast<uint8_t>(bitBuffer & 0xFF));
+            bitBuffer >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    // 数据子块最多255字节，写满即输出
+    void pushByte(uint8_t byte) {
+        block.push_back(byte);
+        if (block.size() == 255) {
+            file.put(static_cast<char>(255));
+            file.write(reinterpret_cast<const char*>(block.data()), 255);
+            block.clear();
+        }
+    }
+
+    /*
+     * LZW编码函数
+     * 最小码长8位：清除码256、结束码257，码长从9位增长到12位，字典满4096项时发出清除码重建
+     */
+    void encodeLZW(const std::vector<uint8_t>& pixels) {
+        const int clearCode = 256;
+        const int endCode = 257;
+        file.put(8);
+        bitBuffer = 0;
+        bitCount = 0;
+        block.clear();
+
+        int codeSize = 9;
+        int nextCode = endCode + 1;
+        std::fill(dictKeys.begin(), dictKeys.end(), -1);
+        emitCode(clearCode, codeSize);
+
+        int prefix = pixels[0];
+        for (size_t i = 1; i < pixels.size(); ++i) {
+            const int pixel = pixels[i];
+            const int32_t key = (prefix << 8) | pixel;
+            int slot = static_cast<int>((static_cast<uint32_t>(key) * 2654435761u) >> 19);  // 13位哈希
+            while (dictKeys[slot] != -1 && dictKeys[slot] != key) {
+                slot = (slot + 1) & (DICT_SIZE - 1);
+            }
+            if (dictKeys[slot] == key) {
+                prefix = dictCodes[slot];
+                continue;
+            }
+
+            emitCode(prefix, codeSize);
+            if (nextCode < 4096) {
+                dictKeys[slot] = key;
+                dictCodes[slot] = static_cast<int16_t>(nextCode);
+                if (nextCode++ == (1 << codeSize) && codeSize < 12) {
+                    codeSize++;
+                }
+            } else {
+                emitCode(clearCode, codeSize);
+                std::fill(dictKeys.begin(), dictKeys.end(), -1);
+                codeSize = 9;
+                nextCode = endCode + 1;
+            }
+            prefix = pixel;
+        }
+        emitCode(prefix, codeSize);
+        emitCode(endCode, codeSize);
+        if (bitCount > 0) {
+            pushByte(static_cast<uint8_t>(bitBuffer & 0xFF));
+        }
+        if (!block.empty()) {
+            file.put(static_cast<char>(block.size()));
+            file.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+        }
+        file.put(0);  // 块结束
+    }
+};
+
+#ifdef MIKU_HAS_WEBP
+/*
+ * WebPAnimWriter类
+ * 动画WebP写出器：libwebp的动画编码器按无损模式编码，
+ * 编码器自行求帧间差异矩形并选择是否与上一帧混合，ASCII帧颜色少、背景纯黑，无损模式文件很小
+ */
+class WebPAnimWriter {
+private:
+    std::string path;
+    WebPAnimEncoder* encoder;
+    WebPConfig config;
+    double fps;
+    int frames;
+    cv::Mat bgr;             // 灰度帧转换为三通道后的图像
+
+public:
+    WebPAnimWriter() : encoder(nullptr), fps(0.0), frames(0) {}
+
+    ~WebPAnimWriter() {
+        if (encoder) {
+            WebPAnimEncoderDelete(encoder);
+        }
+    }
+
+    WebPAnimWriter(const WebPAnimWriter&) = delete;
+    WebPAnimWriter& operator=(const WebPAnimWriter&) = delete;
+
+    bool isOpen() const { return encoder != nullptr; }
+
+    bool open(const std::string& outputPath, double outputFps, cv::Size frameSize) {
+        WebPAnimEncoderOptions encoderOptions;
+        if (!WebPAnimEncoderOptionsInit(&encoderOptions) || !WebPConfigInit(&config)) {
+            return false;
+        }
+        encoderOptions.anim_params.loop_count = 0;
+        config.lossless = 1;
+        config.method = ASCIIVideoConstants::WEBP_METHOD;
+        config.quality = ASCIIVideoConstants::WEBP_EFFORT;
+        encoder = WebPAnimEncoderNew(frameSize.width, frameSize.height, &encoderOptions);
+        if (!encoder) {
+            std::cerr << "无法创建WebP编码器" << std::endl;
+            return false;
+        }
+        path = outputPath;
+        fps = outputFps;
+        frames = 0;
+        std::cout << "输出动画WebP（无损）: " << path << std::endl;
+        return true;
+    }
+
+    void write(const cv::Mat& frame) {
+        const cv::Mat* source = &frame;
+        if (frame.channels() == 1) {
+            cv::cvtColor(frame, bgr, cv::COLOR_GRAY2BGR);
+            source = &bgr;
+        }
+        WebPPicture picture;
+        WebPPictureInit(&picture);
+        picture.use_argb = 1;
+        picture.width = source->cols;
+        picture.height = source->rows;
+        if (WebPPictureImportBGR(&picture, source->data, static_cast<int>(source->step)) &&
+            WebPAnimEncoderAdd(encoder, &picture, static_cast<int>(std::lround(frames * 1000.0 / fps)), &config)) {
+            frames++;
+        }
+        WebPPictureFree(&picture);
+    }
+
+    // 组装并写出文件；返回值表示是否写出成功
+    bool finish() {
+        if (!encoder) {
+            return true;
+        }
+        WebPData data;
+        WebPDataInit(&data);
+        bool ok = WebPAnimEncoderAdd(encoder, nullptr, static_cast<int>(std::lround(frames * 1000.0 / fps)), nullptr) &&
+                  WebPAnimEncoderAssemble(encoder, &data);
+        if (ok) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(data.bytes), static_cast<std::streamsize>(data.size));
+            ok = static_cast<bool>(out);
+        }
+        if (!ok) {
+            std::cerr << "WebP写出失败: " << path << std::endl;
+        }
+        WebPDataClear(&data);
+        WebPAnimEncoderDelete(encoder);
+        encoder = nullptr;
+        return ok;
+    }
+};
+#endif
+
+/*
+ * EnhancedASCIIConverter类
+ * 主转换器类，负责将视频转换为ASCII艺术风格
+ * 使用RAII（资源获取即初始化）原则管理资源
+ */
+class EnhancedASCIIConverter {
+private:
+    // 当前使用的字符集字符串（UTF-8）
+    std::string currentCharset;
+
+    // 字符集解码后的码位，字形编号即在其中的位置
+    std::vector<char32_t> glyphCodepoints;
+
+    // 每个字形占的字符格数：字符集含全角字符时为2
+    int glyphSpan;
+
+    // 已处理的帧计数器
+    int frameCount;
+
+    // 转换选项
+    ConversionOptions options;
+
+    // 积分图（积分图分析路径和兴趣区域模式使用），帧间复用内存
+    SummedAreaTable areaTable;
+
+    // 线性光查找表，未启用线性光时为空
+    const LinearLightLUT* linearLUT;
+
+    // 亮度到字符的查找表：8位亮度 -> 字形编号（字符集中的位置），自动色阶的拉伸也折算在表内
+    uchar glyphLut[256];
+
+    // 字形图集，字符集确定后建立
+    GlyphAtlas atlas;
+
+    // 覆盖率补偿：每个字形的颜色增益（8位定点，256为1），图集建立后计算
+    uint16_t glyphGain[ASCIIVideoConstants::MAX_CHARSET_GLYPHS];
+
+    // 自动色阶：当前帧字符格亮度直方图，以及平滑后的黑位、白位
+    int lumaHistogram[256];
+    double levelLow;
+    double levelHigh;
+
+    // 感知时间滤波：Lab查找表、每个字符格保持的颜色及其Lab值、上一帧输出
+    const LabColorLUT* labLUT;
+    cv::Mat heldColors;
+    std::vector<int> heldLab;
+    cv::Mat lastAsciiFrame;
+    int duplicateFrames;
+
+    // 分析结果：当前帧和上一帧的字符网格（字形编号和颜色平面），渲染和网格文件都从这里读取
+    AsciiGrid frameGrid;
+    AsciiGrid previousGrid;
+
+    // 异步写出器：图像序列的逐帧文件和字符网格文件都经它写盘
+    AsyncFileWriter fileWriter;
+    bool gridOutputOpen;
+    int gridFrames;          // 已写入的网格帧数
+    int gridKeyframes;       // 其中的原始帧（关键帧）数
+    size_t gridBytes;        // 网格帧记录的总字节数
+    AsciiGrid gridReference; // 上一次写入网格文件的网格，预测帧的颜色记为与它的差值
+
+    // 图像序列输出：文件名模板（如 frames/%06d.png）、图像格式扩展名和下一帧编号，不是图像序列时为空
+    std::string sequencePattern;
+    std::string sequenceExtension;
+    int sequenceIndex;
+
+    // 动画图像输出（输出路径为 .gif / .webp 时）
+    GifWriter gifOutput;
+#ifdef MIKU_HAS_WEBP
+    WebPAnimWriter webpOutput;
+#endif
+
+    // 分段输出（--segment），以及最近一次打开视频写入器时选定的编码器
+    SegmentedOutput segmentedOutput;
+    int outputFourcc;
+
+    // 流式转换接口的采样网格大小和中间结果
+    cv::Size streamSampleSize;
+    cv::Mat streamResized;
+    cv::Mat streamLinearFrame, streamLinearResized;
+
+    // 隔行更新：本帧渲染的起始行和行间隔（未启用或首帧时为0和1），以及跨帧保留的输出帧
+    int rowPhase;
+    int rowStep;
+    cv::Mat interlacedFrame;
+
+public:
+    /*
+     * 构造函数
+     * 初始化帧计数器、字符集和转换选项
+     */
+    explicit EnhancedASCIIConverter(const ConversionOptions& opts = ConversionOptions())
+        : frameCount(0), options(opts),
+          linearLUT(opts.linearLight ? &LinearLightLUT::instance() : nullptr),
+          levelLow(0.0), levelHigh(255.0),
+          labLUT(opts.hysteresisDeltaE > 0.0 ? &LabColorLUT::instance() : nullptr),
+          duplicateFrames(0), gridOutputOpen(false), gridFrames(0), gridKeyframes(0), gridBytes(0), sequenceIndex(0), outputFourcc(0), rowPhase(0), rowStep(1) {
+        // 从常量命名空间复制ASCII字符集，指定了自定义字符集时使用自定义字符集
+        // 使用字符串复制而不是指针引用，以便后续可能修改字符集
+        currentCharset = opts.charset.empty() ? ASCIIVideoConstants::ASCII_CHARS : opts.charset;
+        decodeUTF8(currentCharset, glyphCodepoints);  // 合法性已在解析参数时检查
+        glyphSpan = 1;
+        for (char32_t cp : glyphCodepoints) {
+            if (isWideCodepoint(cp)) {
+                glyphSpan = 2;
+            }
+        }
+        std::fill(lumaHistogram, lumaHistogram + 256, 0);
+        std::fill(glyphGain, glyphGain + ASCIIVideoConstants::MAX_CHARSET_GLYPHS, 256);
+        rebuildGlyphLut();
+    }
+
+    /*
+     * 主转换函数
+     * 将输入视频转换为彩色ASCII艺术视频
+     *
+     * 参数：
+     *   inputPath: 输入视频文件的路径
+     *   outputPath: 输出视频文件的路径
+     *   asciiWidth: ASCII网格的宽度（每行字符数），默认80
+     *   quality: 质量参数（当前版本未使用，保留用于未来扩展）
+     *
+     * 返回值：
+     *   bool: 转换成功返回true，失败返回false
+     *
+     * 工作流程：
+     *   1. 打开输入视频文件
+     *   2. 获取视频信息（分辨率、帧率、总帧数）
+     *   3. 计算输出视频参数
+     *   4. 创建视频写入器
+     *   5. 逐帧处理视频
+     *   6. 释放资源并输出结果
+     */
+    bool convertToColorASCII(const std::string& inputPath, const std::string& outputPath,
+                             int asciiWidth = ASCIIVideoConstants::DEFAULT_ASCII_WIDTH, double quality = 1.0) {
+        // 先建立字形图集（指定了字体时从字体光栅化）
+        if (!prepareAtlas()) {
+            return false;
+        }
+
+        // 步骤1：打开输入视频文件
+        cv::VideoCapture cap(inputPath);
+        if (!cap.isOpened()) {
+            std::cerr << "无法打开视频文件: " << inputPath << std::endl;
+            return false;
+        }
+
+        // 步骤2：获取视频基本信息
+        double fps = cap.get(cv::CAP_PROP_FPS);  // 帧率（每秒帧数）
+        int totalFrames = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_COUNT));  // 总帧数
+        int originalWidth = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH));  // 原始宽度
+        int originalHeight = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT));  // 原始高度
+
+        // 显示视频信息，让用户了解处理的是什么视频
+        std::cout << "视频信息: " << originalWidth << "x" << originalHeight
+        << ", " << fps << "fps, " << totalFrames << "帧" << std::endl;
+
+        // 可选：手动裁剪或检测黑边，之后每帧只缩放内容区域，网格宽高比也按内容区域计算
+        cv::Rect contentRect(0, 0, originalWidth, originalHeight);
+        if (options.crop.area() > 0) {
+            contentRect = options.crop & contentRect;
+            if (contentRect.area() == 0) {
+                std::cerr << "裁剪区域超出画面范围" << std::endl;
+                return false;
+            }
+            reportCrop(contentRect, originalWidth, originalHeight);
+            originalWidth = contentRect.width;
+            originalHeight = contentRect.height;
+        } else if (options.autoCrop) {
+            contentRect = sampleContentRect(cap, totalFrames, contentRect);
+            reportCrop(contentRect, originalWidth, originalHeight);
+            originalWidth = contentRect.width;
+            originalHeight = contentRect.height;
+        }
+
+        // 黑边检测的跳转读取完成后再启动预读，从文件开头按解码进度向后预读
+        InputPrefetcher prefetcher;
+        if (prefetcher.start(inputPath, readaheadBytes())) {
+            std::cout << "输入预读: 窗口 " << options.readaheadMB << " MB" << std::endl;
+        }
+
+        // 步骤3：计算输出视频参数
+        // 计算ASCII网格高度，保持原始视频的宽高比
+        // 字符格比像素高（6x12），按字符格的实际宽高比换算行数
+        int asciiHeight = computeGridHeight(asciiWidth, originalWidth, originalHeight);
+
+        // 全角字符集：每个字形占两个字符格，网格列数减半，输出画面宽度不变
+        asciiWidth /= glyphSpan;
+
+        // 超采样时分析阶段输出 N 倍分辨率的采样网格，字符生成时再按格求平均
+        // 只在积分图路径上生效：INTER_AREA缩放本身已按面积求平均，再超采样只是多做一遍缩放
+        const bool satPath = options.summedAreaAnalysis && !options.roiEnabled &&
+                             options.batchFrames <= 1 && options.interlace <= 1;
+        const int samples = satPath ? options.supersample : 1;
+        if (options.supersample > 1 && !satPath) {
+            std::cout << "提示: --supersample 只用于 --sat 积分图路径，INTER_AREA缩放已按面积求平均，忽略" << std::endl;
+        }
+        cv::Size sampleSize(asciiWidth * samples, asciiHeight * samples);
+
+        // 计算输出视频的实际分辨率
+        // 每个ASCII字符占据固定像素大小，所以总分辨率 = 字符数 × 字符像素大小
+        cv::Size frameSize(asciiWidth * atlas.cellWidth(),
+                           asciiHeight * ASCIIVideoConstants::ASCII_CHAR_HEIGHT);
+
+        std::cout << "输出尺寸: " << frameSize.width << "x" << frameSize.height << std::endl;
+        std::cout << "ASCII网格: " << asciiWidth << "x" << asciiHeight << " 字符" << std::endl;
+        if (samples > 1) {
+            std::cout << "超采样: 每个字符格 " << samples << "x" << samples << " 个采样点" << std::endl;
+        }
+        std::cout << "使用字符集: " << glyphCodepoints.size() << " 个字符"
+                  << (glyphSpan > 1 ? "（全角，每个字符占两格）" : "") << std::endl;
+
+        // 步骤4：创建视频写入器
+        cv::VideoWriter writer;
+        if (!openVideoWriter(writer, outputPath, fps, frameSize) ||
+            !openGridOutput(fps, asciiWidth, asciiHeight)) {
+            cap.release();
+            return false;
+        }
+
+        // 步骤5：逐帧处理视频
+        cv::Mat frame, resized;  // 原始帧和调整大小后的帧
+        cv::Mat previousResized;  // 上一帧缩放结果，用于检测场景切换
+        cv::Mat linearFrame, linearResized;  // 线性光模式下的16位中间结果
+        frameCount = 0;  // 重置帧计数器
+
+        // 场景切换后重新检测黑边：在接下来的若干帧中累积内容区域，再一次性应用
+        // 网格尺寸按首次检测的内容区域确定，新的内容区域先扩展到相同宽高比（保留部分黑边），避免画面变形
+        int cropSamplesLeft = 0;
+        cv::Rect pendingRect;
+        const double contentAspect = static_cast<double>(contentRect.width) / contentRect.height;
+
+        // 兴趣区域在网格中的位置（以字符格为单位），裁剪区域变化时重新计算
+        cv::Rect roiCells;
+        if (options.roiEnabled) {
+            roiCells = computeROICells(contentRect, asciiWidth, asciiHeight);
+        }
+
+        std::cout << "开始转换视频..." << std::endl;
+
+        // 显示字符集信息，帮助用户理解亮度到字符的映射关系
+        testCharacterDisplay();
+
+        // 批量分析：一批帧的原始画面和连续存放的缩放结果（第k帧占第k个行带）
+        std::vector<cv::Mat> batchFrames(options.batchFrames);
+        cv::Mat batchResized, batchGlyphs, glyphBand;
+        int batchCount = 0, batchCursor = 0;
+
+        // 主处理循环：读取、处理、写入每一帧
+        while (true) {
+            if (options.batchFrames > 1) {
+                // 当前批次用完后读入下一批并一次性完成缩放
+                if (batchCursor == batchCount) {
+                    batchCount = analyseBatch(cap, batchFrames, contentRect, sampleSize, batchResized, batchGlyphs);
+                    batchCursor = 0;
+                }
+                if (batchCount == 0) {
+                    break;  // 视频已结束
+                }
+                frame = batchFrames[batchCursor++];
+            } else {
+                cap >> frame;  // 从视频捕获对象读取下一帧
+                if (frame.empty()) {
+                    break;  // 如果读取到空帧，说明视频已结束
+                }
+            }
+            prefetcher.advance(frameCount + 1, totalFrames);
+
+            // 5.1 调整帧大小到ASCII网格尺寸
+            // 使用INTER_AREA插值方法，适合缩小图像
+            // 启用裁剪时只取内容区域（ROI视图，不拷贝像素）
+            // 积分图路径：建表一次，均匀网格和兴趣区域网格都从表中O(1)求平均；
+            // 兴趣区域模式只有检测场景切换时才需要均匀网格
+            // 线性光模式：积分图建表时直接查表转换；缩放路径先经查找表转为16位线性光，
+            // 用INTER_AREA在16位整数上求平均（OpenCV内部向量化），再查反向表转回sRGB
+            // 隔行更新模式：只缩放本帧要更新的字符行对应的源画面条带
+            // 批量模式：缩放已在读入整批时完成，直接取批次中本帧的行带
+            if (options.batchFrames > 1) {
+                int band = batchCursor - 1;
+                resized = batchResized.rowRange(band * sampleSize.height, (band + 1) * sampleSize.height);
+                if (!batchGlyphs.empty()) {
+                    glyphBand = batchGlyphs.rowRange(band * sampleSize.height, (band + 1) * sampleSize.height);
+                }
+            } else if (options.interlace > 1) {
+                analyseInterlacedRows(frame(contentRect), sampleSize, samples, resized);
+            } else if (options.summedAreaAnalysis || options.roiEnabled) {
+                areaTable.build(frame(contentRect), linearLUT);
+                if (!options.roiEnabled || options.autoCrop) {
+                    areaTable.cellMeans(sampleSize.width, sampleSize.height, resized);
+                }
+            } else if (linearLUT) {
+                cv::LUT(frame(contentRect), linearLUT->toLinearMat, linearFrame);
+                cv::resize(linearFrame, linearResized, sampleSize, 0, 0, cv::INTER_AREA);
+                linearLUT->linearToSRGB(linearResized, resized);
+            } else {
+                cv::resize(frame(contentRect), resized, sampleSize, 0, 0, cv::INTER_AREA);
+            }
+
+            // 场景切换时重新检测黑边，新镜头可能使用不同的画幅
+            if (options.autoCrop) {
+                if (cropSamplesLeft == 0 && !previousResized.empty() && isSceneCut(previousResized, resized)) {
+                    cropSamplesLeft = ASCIIVideoConstants::AUTOCROP_SAMPLE_FRAMES;
+                    pendingRect = cv::Rect();
+                }
+                if (cropSamplesLeft > 0) {
+                    pendingRect = unionRect(pendingRect, detectContentRect(frame));
+                    cv::Rect fitted;
+                    if (--cropSamplesLeft == 0 && isUsableCrop(pendingRect, frame.size()) &&
+                        fitCropAspect(pendingRect, contentAspect, frame.size(), fitted) && fitted != contentRect) {
+                        contentRect = fitted;
+                        std::cout << "场景切换，重新检测黑边 (第" << frameCount << "帧)" << std::endl;
+                        reportCrop(contentRect, frame.cols, frame.rows);
+                        if (options.roiEnabled) {
+                            roiCells = computeROICells(contentRect, asciiWidth, asciiHeight);
+                        }
+                    }
+                }
+                resized.copyTo(previousResized);
+            }
+
+            // 5.2 将调整大小后的帧转换为ASCII艺术帧
+            cv::Mat asciiFrame = options.roiEnabled
+                ? generateVariableDensityFrame(asciiWidth, asciiHeight, roiCells)
+                : renderFrame(resized, samples, glyphBand);
+
+            // 5.3 将ASCII艺术帧写入输出视频或图像序列（以及字符网格文件）
+            writeOutputFrame(writer, asciiFrame);
+            writeGridFrameIfEnabled();
+
+            // 5.4 更新帧计数器并显示进度
+            frameCount++;
+            reportProgress(totalFrames);
+        }
+
+        // 步骤6：释放资源
+        cap.release();   // 释放视频捕获对象
+        if (!closeOutput(writer)) {  // 释放视频写入对象，等待异步写出完成
+            return false;
+        }
+
+        std::cout << "转换完成! 总帧数: " << frameCount << std::endl;
+        reportDuplicateFrames();
+        std::cout << "输出文件: " << outputPath << std::endl;
+        return true;  // 转换成功
+                             }
+
+    /*
+     * 拼接模式转换函数
+     * 将多个输入视频同时解码，分别渲染到同一个ASCII网格的子区域中，输出一个视频
+     *
+     * 参数：
+     *   inputPaths: 输入视频路径列表，按行优先顺序填充子区域
+     *   outputPath: 输出视频文件的路径
+     *   asciiWidth: 整个ASCII网格的宽度（每行字符数）
+     *   mosaicCols: 子区域列数
+     *   mosaicRows: 子区域行数
+     *
+     * 返回值：
+     *   bool: 转换成功返回true，失败返回false
+     *
+     * 工作流程：
+     *   1. 为每个输入创建独立解码线程（解码和缩放并行进行）
+     *   2. 以第一个输入的帧率作为输出时钟
+     *   3. 每个输出帧按时间戳从各输入取最新的帧，拼接成一个网格图像
+     *   4. 整个网格只渲染、编码一次，无需先分别转换再在外部合成
+     */
+    bool convertMosaicASCII(const std::vector<std::string>& inputPaths, const std::string& outputPath,
+                            int asciiWidth, int mosaicCols, int mosaicRows) {
+        if (!prepareAtlas()) {
+            return false;
+        }
+
+        // 步骤1：读取第一个输入的信息，用于确定网格高度和输出帧率
+        cv::VideoCapture probe(inputPaths[0]);
+        if (!probe.isOpened()) {
+            std::cerr << "无法打开视频文件: " << inputPaths[0] << std::endl;
+            return false;
+        }
+        int originalWidth = static_cast<int>(probe.get(cv::CAP_PROP_FRAME_WIDTH));
+        int originalHeight = static_cast<int>(probe.get(cv::CAP_PROP_FRAME_HEIGHT));
+        probe.release();
+
+        // 每个子区域沿用单输入模式的宽高比计算方式
+        int tileWidth = asciiWidth / mosaicCols;
+        int tileHeight = computeGridHeight(tileWidth, originalWidth, originalHeight);
+        int asciiHeight = tileHeight * mosaicRows;
+        asciiWidth /= glyphSpan;  // 全角字符集：网格列数减半
+
+        // 步骤2：为每个输入创建解码器，子区域边界按比例划分，宽度不能整除时也能铺满网格
+        std::vector<std::unique_ptr<MosaicInputDecoder>> decoders;
+        std::vector<cv::Rect> tileRects;
+        for (size_t i = 0; i < inputPaths.size(); ++i) {
+            int col = static_cast<int>(i) % mosaicCols;
+            int row = static_cast<int>(i) / mosaicCols;
+            int x0 = col * asciiWidth / mosaicCols;
+            int x1 = (col + 1) * asciiWidth / mosaicCols;
+            cv::Rect rect(x0, row * tileHeight, x1 - x0, tileHeight);
+
+            auto decoder = std::make_unique<MosaicInputDecoder>(inputPaths[i], rect.size(), readaheadBytes(),
+                                                                linearLUT);
+            if (!decoder->open()) {
+                return false;
+            }
+            decoders.push_back(std::move(decoder));
+            tileRects.push_back(rect);
+        }
+
+        // 以第一个输入为输出时钟，总帧数取最长输入的时长
+        double fps = decoders[0]->getFps();
+        double durationMs = 0.0;
+        for (const auto& decoder : decoders) {
+            durationMs = std::max(durationMs, decoder->getDurationMs());
+        }
+        int totalFrames = static_cast<int>(durationMs * fps / 1000.0);
+
+        cv::Size frameSize(asciiWidth * atlas.cellWidth(),
+                           asciiHeight * ASCIIVideoConstants::ASCII_CHAR_HEIGHT);
+
+        std::cout << "拼接布局: " << mosaicCols << "x" << mosaicRows << ", " << inputPaths.size() << " 个输入" << std::endl;
+        std::cout << "输出尺寸: " << frameSize.width << "x" << frameSize.height << ", " << fps << "fps" << std::endl;
+        std::cout << "ASCII网格: " << asciiWidth << "x" << asciiHeight << " 字符" << std::endl;
+
+        // 步骤3：创建视频写入器
+        cv::VideoWriter writer;
+        if (!openVideoWriter(writer, outputPath, fps, frameSize) ||
+            !openGridOutput(fps, asciiWidth, asciiHeight)) {
+            return false;
+        }
+
+        // 步骤4：启动所有解码线程
+        for (auto& decoder : decoders) {
+            decoder->start();
+        }
+
+        // 步骤5：按输出时钟合成、渲染并写入每一帧
+        // 未被任何输入占用的子区域保持黑色
+        cv::Mat composite(asciiHeight, asciiWidth, CV_8UC3, cv::Scalar(0, 0, 0));
+        frameCount = 0;
+
+        std::cout << "开始转换视频..." << std::endl;
+
+        while (true) {
+            double targetMs = frameCount * 1000.0 / fps;
+
+            // 所有输入的最后一帧都已在之前的输出帧中显示过，结束转换
+            bool allExhausted = true;
+            for (const auto& decoder : decoders) {
+                if (!decoder->exhausted()) {
+                    allExhausted = false;
+                    break;
+                }
+            }
+            if (allExhausted) {
+                break;
+            }
+
+            // 取出各输入在当前时刻应显示的帧，拷贝到对应子区域
+            for (size_t i = 0; i < decoders.size(); ++i) {
+                decoders[i]->frameAt(targetMs).copyTo(composite(tileRects[i]));
+            }
+
+            cv::Mat asciiFrame = renderFrame(composite, 1);
+            writeOutputFrame(writer, asciiFrame);
+            writeGridFrameIfEnabled();
+
+            frameCount++;
+            reportProgress(totalFrames);
+        }
+
+        // 步骤6：释放资源（解码器在析构时等待解码线程退出）
+        if (!closeOutput(writer)) {
+            return false;
+        }
+
+        std::cout << "转换完成! 总帧数: " << frameCount << std::endl;
+        reportDuplicateFrames();
+        std::cout << "输出文件: " << outputPath << std::endl;
+        return true;
+    }
+
+    /*
+     * 流式转换接口
+     * 供并发任务调度使用：读帧、写帧由调用方在自己选择的线程上完成，转换器只负责单帧转换
+     *   beginStream: 建立字形图集，计算网格和输出尺寸
+     *   openOutput: 打开视频写入器（或图像序列）
+     *   writeOutputFrame / closeOutput: 写出一帧、结束输出
+     *   convertFrame: 缩放（线性光模式经查找表）并渲染一帧
+     */
+    bool beginStream(int asciiWidth, int sourceWidth, int sourceHeight, cv::Size& frameSize) {
+        if (!prepareAtlas()) {
+            return false;
+        }
+        int asciiHeight = computeGridHeight(asciiWidth, sourceWidth, sourceHeight);
+        asciiWidth /= glyphSpan;
+        streamSampleSize = cv::Size(asciiWidth, asciiHeight);  // 流式转换总是INTER_AREA缩放，不超采样
+        frameSize = cv::Size(asciiWidth * atlas.cellWidth(), asciiHeight * ASCIIVideoConstants::ASCII_CHAR_HEIGHT);
+        frameCount = 0;
+        return true;
+    }
+
+    bool openOutput(cv::VideoWriter& writer, const std::string& outputPath, double fps, cv::Size frameSize) {
+        return openVideoWriter(writer, outputPath, fps, frameSize);
+    }
+
+    /*
+     * 写出一帧函数
+     * 视频输出交给视频写入器；图像序列在当前线程编码到写出缓冲区，写盘由写出线程完成
+     */
+    void writeOutputFrame(cv::VideoWriter& writer, const cv::Mat& asciiFrame) {
+        if (segmentedOutput.isOpen()) {
+            segmentedOutput.write(asciiFrame);
+            return;
+        }
+        if (gifOutput.isOpen()) {
+            gifOutput.write(asciiFrame);
+            return;
+        }
+#ifdef MIKU_HAS_WEBP
+        if (webpOutput.isOpen()) {
+            webpOutput.write(asciiFrame);
+            return;
+        }
+#endif
+        if (sequencePattern.empty()) {
+            writer.write(asciiFrame);
+            return;
+        }
+        char path[4096];
+        std::snprintf(path, sizeof(path), sequencePattern.c_str(), sequenceIndex++);
+        AsyncFileWriter::Buffer id;
+        cv::imencode(sequenceExtension, asciiFrame, fileWriter.acquire(id));
+        fileWriter.writeFile(id, path);
+    }
+
+    /*
+     * 结束输出函数
+     * 释放视频写入器，等待分段编码线程以及异步写出的图像序列和字符网格文件全部写完
+     *
+     * 返回值：
+     *   bool: 有写入失败时返回false
+     */
+    bool closeOutput(cv::VideoWriter& writer) {
+        writer.release();
+        if (gridOutputOpen && gridFrames > 0) {
+            std::cout << "字符网格: " << gridFrames << " 帧（关键帧 " << gridKeyframes << "），平均每帧 "
+                      << gridBytes / gridFrames << " 字节" << std::endl;
+        }
+        gridOutputOpen = false;
+        bool ok = segmentedOutput.finish();
+        ok = gifOutput.finish() && ok;
+#ifdef MIKU_HAS_WEBP
+        ok = webpOutput.finish() && ok;
+#endif
+        return fileWriter.finish() && ok;
+    }
+
+    /*
+     * 字符网格解码函数
+     * 读取 --grid-out 写出的网格文件，逐帧用字形图集渲染成视频（或图像序列、GIF等其他输出）；
+     * 预测帧只更新变化的字符格，渲染器与转换时相同，输出与直接转换一致
+     *
+     * 参数：
+     *   gridPath: 网格文件路径
+     *   outputPath: 输出路径
+     *
+     * 返回值：
+     *   bool: 解码成功返回true
+     *
+     * 转换器的字符集、灰度和渲染模式选项需要与网格文件头一致（由main从文件头读取后设置）
+     */
+    bool decodeGridFile(const std::string& gridPath, const std::string& outputPath) {
+        std::ifstream in(gridPath, std::ios::binary);
+        GridFileHeader header;
+        if (!in || !readGridHeader(in, header)) {
+            std::cerr << "无法读取字符网格文件: " << gridPath << std::endl;
+            return false;
+        }
+        if (!prepareGridAtlas(header)) {
+            return false;
+        }
+        if (atlas.cellWidth() != header.cellWidth || header.cellHeight != ASCIIVideoConstants::ASCII_CHAR_HEIGHT) {
+            std::cerr << "错误: 字符网格文件头中的字形尺寸与字形图集不符" << std::endl;
+            return false;
+        }
+
+        const double fps = header.fpsMilli > 0 ? header.fpsMilli / 1000.0 : 25.0;
+        cv::Size frameSize(header.width * atlas.cellWidth(), header.height * ASCIIVideoConstants::ASCII_CHAR_HEIGHT);
+        std::cout << "字符网格: " << header.width << "x" << header.height << ", " << fps << "fps" << std::endl;
+        cv::VideoWriter writer;
+        if (!openVideoWriter(writer, outputPath, fps, frameSize)) {
+            return false;
+        }
+
+        frameCount = 0;
+        while (readGridFrame(in, header, frameGrid)) {
+            cv::Mat asciiFrame;
+            if (options.mono) {
+                asciiFrame = generateMonoASCIIFrame(frameGrid);
+            } else if (options.backgroundFill) {
+                asciiFrame = generateBackgroundFillFrame(frameGrid);
+            } else {
+                asciiFrame = generateColorASCIIFrame(frameGrid);
+            }
+            writeOutputFrame(writer, asciiFrame);
+            frameCount++;
+        }
+        if (!closeOutput(writer)) {
+            return false;
+        }
+        std::cout << "解码完成! 总帧数: " << frameCount << std::endl;
+        return true;
+    }
+
+    /*
+     * 编码器基准测试函数
+     * 先把输入的前若干帧渲染到内存，再用每个有损和无损编码器分别写出一遍，
+     * 报告各编码器的写出速度、文件大小和相对未压缩数据的压缩比；渲染时间不计入。
+     * 写出的文件再解码回来与渲染结果逐像素比较，报告最大误差，误差为0时才标记为无损
+     *
+     * 参数：
+     *   inputPath: 输入视频
+     *   asciiWidth: ASCII宽度
+     *   frameLimit: 参与测试的帧数
+     *
+     * 返回值：
+     *   bool: 输入无法打开或没有读到帧时返回false
+     */
+    bool benchmarkCodecs(const std::string& inputPath, int asciiWidth, int frameLimit) {
+        cv::VideoCapture cap(inputPath);
+        if (!cap.isOpened()) {
+            std::cerr << "无法打开视频文件: " << inputPath << std::endl;
+            return false;
+        }
+        double fps = cap.get(cv::CAP_PROP_FPS);
+        if (fps <= 0.0) {
+            fps = 25.0;
+        }
+        cv::Size frameSize;
+        if (!beginStream(asciiWidth, static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH)),
+                         static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT)), frameSize)) {
+            return false;
+        }
+
+        // 渲染测试帧
+        std::vector<cv::Mat> frames;
+        cv::Mat frame;
+        while (static_cast<int>(frames.size()) < frameLimit && cap.read(frame)) {
+            frames.push_back(convertFrame(frame).clone());
+        }
+        if (frames.empty()) {
+            std::cerr << "没有读到可用于测试的帧: " << inputPath << std::endl;
+            return false;
+        }
+        const double rawMB = static_cast<double>(frames.size()) * frames[0].total() * frames[0].elemSize() / (1024.0 * 1024.0);
+        std::cout << "编码器基准测试: " << frames.size() << " 帧, " << frameSize.width << "x" << frameSize.height
+                  << ", 未压缩 " << std::fixed << std::setprecision(1) << rawMB << " MB" << std::endl;
+        std::cout << "编码器    容器    写出fps    文件MB    压缩比  最大误差" << std::endl;
+
+        const char* tmpdir = std::getenv("TMPDIR");
+        const std::string directory = tmpdir && *tmpdir ? tmpdir : "/tmp";
+        for (bool lossless : {false, true}) {
+            for (const auto& codec : videoCodecs(lossless)) {
+                const std::string path = directory + "/miku_bench_" + codec.name + codec.container;
+                std::cout << std::left << std::setw(10) << codec.name << std::setw(8) << codec.container << std::right;
+                cv::VideoWriter writer;
+                double start = static_cast<double>(cv::getTickCount());
+                if (!writer.open(path, codec.fourcc, fps, frameSize, !options.mono)) {
+                    std::cout << "不可用" << std::endl;
+                    continue;
+                }
+                for (const cv::Mat& rendered : frames) {
+                    writer.write(rendered);
+                }
+                writer.release();
+                double seconds = (cv::getTickCount() - start) / cv::getTickFrequency();
+
+                struct stat info;
+                double fileMB = ::stat(path.c_str(), &info) == 0 ? info.st_size / (1024.0 * 1024.0) : 0.0;
+                int maxError = decodeError(path, frames);
+                std::remove(path.c_str());
+                std::cout << std::setw(9) << std::setprecision(1) << frames.size() / seconds
+                          << std::setw(10) << std::setprecision(2) << fileMB
+                          << std::setw(10) << std::setprecision(1) << (fileMB > 0.0 ? rawMB / fileMB : 0.0)
+                          << std::setw(10);
+                if (maxError < 0) {
+                    std::cout << "无法解码" << std::endl;
+                } else {
+                    std::cout << maxError << (maxError == 0 ? "  无损" : lossless ? "  （有误差，不是无损）" : "") << std::endl;
+                }
+            }
+        }
+        return true;
+    }
+
+    /*
+     * 解码比对函数
+     * 把写出的视频解码回来，与渲染结果逐像素比较
+     *
+     * 返回值：
+     *   int: 所有帧中单个通道的最大绝对误差；无法打开或帧数不足时返回-1
+     */
+    static int decodeError(const std::string& path, const std::vector<cv::Mat>& frames) {
+        cv::VideoCapture check(path);
+        if (!check.isOpened()) {
+            return -1;
+        }
+        double maxError = 0.0;
+        cv::Mat decoded, compared;
+        for (const cv::Mat& rendered : frames) {
+            if (!check.read(decoded) || decoded.size() != rendered.size()) {
+                return -1;
+            }
+            // 灰度输出解码后是三通道，取第一个通道比较
+            if (rendered.channels() == 1 && decoded.channels() == 3) {
+                cv::extractChannel(decoded, compared, 0);
+            } else {
+                compared = decoded;
+            }
+            maxError = std::max(maxError, cv::norm(compared, rendered, cv::NORM_INF));
+        }
+        return static_cast<int>(maxError);
+    }
+
+    cv::Mat convertFrame(const cv::Mat& frame) {
+        if (linearLUT) {
+            cv::LUT(frame, linearLUT->toLinearMat, streamLinearFrame);
+            cv::resize(streamLinearFrame, streamLinearResized, streamSampleSize, 0, 0, cv::INTER_AREA);
+            linearLUT->linearToSRGB(streamLinearResized, streamResized);
+        } else {
+            cv::resize(frame, streamResized, streamSampleSize, 0, 0, cv::INTER_AREA);
+        }
+        cv::Mat asciiFrame = renderFrame(streamResized, 1);
+        frameCount++;
+        return asciiFrame;
+    }
+
+    int getFrameCount() const {
+        return frameCount;
+    }
+
+private:
+    /*
+     * 黑边检测函数
+     * 找出单帧中平均亮度高于阈值的行和列所围成的内容区域
+     *
+     * 参数：
+     *   frame: 原始分辨率的彩色帧
+     *
+     * 返回值：
+     *   cv::Rect: 内容区域；整帧都是黑色（如淡出画面）时返回空矩形
+     */
+    cv::Rect detectContentRect(const cv::Mat& frame) {
+        cv::Mat gray;
+        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+
+        // 一次遍历同时累加每行和每列的亮度总和
+        std::vector<long long> rowSum(gray.rows, 0), colSum(gray.cols, 0);
+        for (int y = 0; y < gray.rows; ++y) {
+            const uchar* row = gray.ptr<uchar>(y);
+            long long sum = 0;
+            for (int x = 0; x < gray.cols; ++x) {
+                sum += row[x];
+                colSum[x] += row[x];
+            }
+            rowSum[y] = sum;
+        }
+
+        long long rowLimit = static_cast<long long>(ASCIIVideoConstants::AUTOCROP_BLACK_THRESHOLD) * gray.cols;
+        long long colLimit = static_cast<long long>(ASCIIVideoConstants::AUTOCROP_BLACK_THRESHOLD) * gray.rows;
+
+        int top = 0, bottom = gray.rows - 1, left = 0, right = gray.cols - 1;
+        while (top <= bottom && rowSum[top] < rowLimit) top++;
+        while (bottom >= top && rowSum[bottom] < rowLimit) bottom--;
+        while (left <= right && colSum[left] < colLimit) left++;
+        while (right >= left && colSum[right] < colLimit) right--;
+
+        if (top > bottom || left > right) {
+            return cv::Rect();  // 全黑帧，无法判断
+        }
+        return cv::Rect(left, top, right - left + 1, bottom - top + 1);
+    }
+
+    /*
+     * 启动时黑边检测函数
+     * 在视频中均匀选取若干帧检测内容区域，取并集以免暗场景被过度裁剪
+     * 检测完成后把读取位置恢复到开头
+     *
+     * 返回值：
+     *   cv::Rect: 内容区域；检测失败或结果不可信时返回fullRect
+     */
+    cv::Rect sampleContentRect(cv::VideoCapture& cap, int totalFrames, const cv::Rect& fullRect) {
+        cv::Rect detected;
+        cv::Mat sample;
+        for (int i = 0; i < ASCIIVideoConstants::AUTOCROP_SAMPLE_FRAMES; ++i) {
+            // 采样位置取 1/6, 2/6 ... 5/6 处，避开片头片尾的黑场
+            int position = totalFrames * (i + 1) / (ASCIIVideoConstants::AUTOCROP_SAMPLE_FRAMES + 1);
+            cap.set(cv::CAP_PROP_POS_FRAMES, position);
+            cap >> sample;
+            if (!sample.empty()) {
+                detected = unionRect(detected, detectContentRect(sample));
+            }
+        }
+        cap.set(cv::CAP_PROP_POS_FRAMES, 0);
+
+        return isUsableCrop(detected, fullRect.size()) ? detected : fullRect;
+    }
+
+    // 合并两个内容区域，空矩形视为不存在
+    static cv::Rect unionRect(const cv::Rect& a, const cv::Rect& b) {
+        if (a.area() == 0) return b;
+        if (b.area() == 0) return a;
+        int x0 = std::min(a.x, b.x);
+        int y0 = std::min(a.y, b.y);
+        int x1 = std::max(a.x + a.width, b.x + b.width);
+        int y1 = std::max(a.y + a.height, b.y + b.height);
+        return cv::Rect(x0, y0, x1 - x0, y1 - y0);
+    }
+
+    /*
+     * 宽高比适配函数
+     * 以内容区域为中心扩展较短的一边，得到宽高比为aspect、包含整个内容区域的矩形（多出的部分是黑边），
+     * 超出画面时平移回画面内
+     *
+     * 返回值：
+     *   bool: 画面内放不下这样的矩形时返回false（例如宽银幕网格遇到4:3镜头），调用方保留原区域
+     */
+    static bool fitCropAspect(const cv::Rect& rect, double aspect, cv::Size frameSize, cv::Rect& fitted) {
+        int width = rect.width;
+        int height = rect.height;
+        if (width < height * aspect) {
+            width = static_cast<int>(std::lround(height * aspect));
+        } else {
+            height = static_cast<int>(std::lround(width / aspect));
+        }
+        if (width > frameSize.width || height > frameSize.height) {
+            return false;
+        }
+        int x = std::clamp(rect.x - (width - rect.width) / 2, 0, frameSize.width - width);
+        int y = std::clamp(rect.y - (height - rect.height) / 2, 0, frameSize.height - height);
+        fitted = cv::Rect(x, y, width, height);
+        return true;
+    }
+
+    // 内容区域至少占画面四分之一才采用，避免把暗场景误判为黑边
+    static bool isUsableCrop(const cv::Rect& rect, cv::Size frameSize) {
+        return rect.area() * 4 >= frameSize.area();
+    }
+
+    /*
+     * 场景切换检测函数
+     * 比较相邻两帧缩放后的网格图像，平均差异超过阈值视为切换镜头
+     * 网格图像很小，检测成本可以忽略
+     */
+    static bool isSceneCut(const cv::Mat& previous, const cv::Mat& current) {
+        cv::Mat diff;
+        cv::absdiff(previous, current, diff);
+        cv::Scalar meanDiff = cv::mean(diff);
+        return (meanDiff[0] + meanDiff[1] + meanDiff[2]) / 3.0 > ASCIIVideoConstants::SCENE_CUT_THRESHOLD;
+    }
+
+    // 输出检测到的裁剪区域
+    static void reportCrop(const cv::Rect& rect, int frameWidth, int frameHeight) {
+        std::cout << "黑边裁剪: " << rect.width << "x" << rect.height << "+" << rect.x << "+" << rect.y
+        << " (原始 " << frameWidth << "x" << frameHeight << ")" << std::endl;
+    }
+
+    /*
+     * 打开字符网格输出文件函数
+     * 未指定 --grid-out 时直接返回true；否则写入文件头（网格大小、字形像素大小、帧率、渲染模式、字符集、字形图集）
+     */
+    bool openGridOutput(double fps, int gridWidth, int gridHeight) {
+        if (options.gridOutputPath.empty()) {
+            return true;
+        }
+        GridFileHeader header;
+        header.width = static_cast<uint16_t>(gridWidth);
+        header.height = static_cast<uint16_t>(gridHeight);
+        header.cellWidth = static_cast<uint16_t>(atlas.cellWidth());
+        header.cellHeight = static_cast<uint16_t>(ASCIIVideoConstants::ASCII_CHAR_HEIGHT);
+        header.fpsMilli = static_cast<uint32_t>(std::lround(fps * 1000.0));
+        header.mono = options.mono ? 1 : 0;
+        header.modes = static_cast<uint8_t>((options.backgroundFill ? GridFormat::MODE_BACKGROUND_FILL : 0) |
+                                            (options.backgroundGlyphs ? GridFormat::MODE_BACKGROUND_GLYPHS : 0) |
+                                            (options.coverageCompensation ? GridFormat::MODE_COVERAGE_COMPENSATION : 0));
+        header.charset = currentCharset;
+        header.tileWidth = static_cast<uint16_t>(atlas.paddedWidth());
+        header.glyphAlpha = atlas.tiles();
+        std::ostringstream headerBytes;
+        writeGridHeader(headerBytes, header);
+
+        // 文件头和帧记录都经异步写出器追加写入
+        if (!fileWriter.open(static_cast<size_t>(gridWidth) * gridHeight * 4 + 64) ||
+            !fileWriter.openAppend(options.gridOutputPath)) {
+            std::cerr << "无法创建字符网格文件: " << options.gridOutputPath << std::endl;
+            return false;
+        }
+        AsyncFileWriter::Buffer id;
+        std::vector<uchar>& buffer = fileWriter.acquire(id);
+        const std::string bytes = headerBytes.str();
+        buffer.assign(bytes.begin(), bytes.end());
+        fileWriter.append(id);
+        gridOutputOpen = true;
+        gridFrames = gridKeyframes = 0;
+        gridBytes = 0;
+        std::cout << "字符网格输出: " << options.gridOutputPath << std::endl;
+        return true;
+    }
+
+    /*
+     * 把本帧字符网格编码到写出缓冲区并提交追加（未启用时不做任何事）；写入错误在结束输出时报告
+     * 首帧和每隔GRID_KEYFRAME_INTERVAL帧写原始帧（便于跳转），其余帧按renderFrame中
+     * markChanges得到的变化标志写预测帧；预测帧不比原始帧小时改写原始帧。
+     * 帧记录都经deflate压缩（miku_grid.h），压缩在渲染线程上完成（120x56网格每帧约1.5毫秒）
+     */
+    void writeGridFrameIfEnabled() {
+        if (!gridOutputOpen) {
+            return;
+        }
+        AsyncFileWriter::Buffer id;
+        std::vector<uchar>& buffer = fileWriter.acquire(id);
+        const bool keyframe = gridFrames % ASCIIVideoConstants::GRID_KEYFRAME_INTERVAL == 0;
+        if (keyframe || !appendGridDelta(buffer, frameGrid, gridReference)) {
+            appendGridFrame(buffer, frameGrid);
+            gridKeyframes++;
+        }
+        gridReference.copyFrom(frameGrid);
+        gridFrames++;
+        gridBytes += buffer.size();
+        fileWriter.append(id);
+    }
+
+    // 输出路径扩展名判断（不区分大小写）
+    static bool hasExtension(const std::string& path, const std::string& extension) {
+        if (path.size() < extension.size()) {
+            return false;
+        }
+        return std::equal(extension.begin(), extension.end(), path.end() - extension.size(),
+                          [](char a, char b) { return a == std::tolower(static_cast<unsigned char>(b)); });
+    }
+
+    // 图像序列输出判断：输出路径中含有帧编号占位符（如 %06d）时逐帧写成图像文件
+    static bool isImageSequencePath(const std::string& path) {
+        return path.find('%') != std::string::npos;
+    }
+
+    /*
+     * 打开图像序列输出函数
+     * 检查文件名模板（恰好一个 %d 形式的帧编号，可带宽度，如 %06d）和图像格式，
+     * 按一帧未压缩大小预留写出缓冲区
+     */
+    bool openImageSequence(const std::string& pattern, cv::Size frameSize) {
+        size_t percent = pattern.find('%');
+        size_t conversion = pattern.find_first_not_of("0123456789", percent + 1);
+        if (conversion == std::string::npos || pattern[conversion] != 'd' ||
+            pattern.find('%', percent + 1) != std::string::npos) {
+            std::cerr << "错误: 图像序列文件名需要恰好一个帧编号占位符，如 frames/%06d.png" << std::endl;
+            return false;
+        }
+        size_t dot = pattern.find_last_of('.');
+        sequenceExtension = dot == std::string::npos || dot < conversion ? "" : pattern.substr(dot);
+        if (sequenceExtension.empty() || !cv::haveImageWriter("frame" + sequenceExtension)) {
+            std::cerr << "错误: 不支持的图像序列格式: " << pattern << std::endl;
+            return false;
+        }
+
+        // 编码结果很少超过未压缩大小，按此预留可让绝大多数帧使用固定缓冲区
+        const size_t rawBytes = static_cast<size_t>(frameSize.area()) * (options.mono ? 1 : 3);
+        if (!fileWriter.open(rawBytes + rawBytes / 64 + 4096)) {
+            return false;
+        }
+        sequencePattern = pattern;
+        sequenceIndex = 0;
+        std::cout << "输出图像序列: " << pattern << std::endl;
+        return true;
+    }
+
+    /*
+     * 打开分段输出函数
+     * 用选定的编码器打开第一段，之后的分段由编码线程沿用同一编码器打开
+     */
+    bool openSegmentedOutput(const std::string& playlistPath, double fps, cv::Size frameSize) {
+        const std::string suffix = ".m3u8";
+        if (playlistPath.size() <= suffix.size() ||
+            playlistPath.compare(playlistPath.size() - suffix.size(), suffix.size(), suffix) != 0) {
+            std::cerr << "错误: --segment 的输出路径应为 .m3u8 播放列表: " << playlistPath << std::endl;
+            return false;
+        }
+        auto firstWriter = std::make_unique<cv::VideoWriter>();
+        std::string firstPath = playlistPath.substr(0, playlistPath.size() - suffix.size()) + "_00000.ts";
+        if (!openEncodedVideo(*firstWriter, firstPath, fps, frameSize, segmentCodecs())) {
+            std::cerr << "错误: 分段输出需要H.264编码器（OpenCV的FFmpeg后端需带libx264或openh264）" << std::endl;
+            return false;
+        }
+        segmentedOutput.open(playlistPath, std::move(firstWriter), outputFourcc, fps, frameSize,
+                             !options.mono, options.segmentSeconds);
+        std::cout << "分段输出: 每段 " << options.segmentSeconds << " 秒, 播放列表 " << playlistPath << std::endl;
+        return true;
+    }
+
+    /*
+     * 创建视频写入器函数
+     * 按输出路径和选项选择输出方式：分段输出、动画GIF/WebP、图像序列或单个视频文件
+     *
+     * 参数：
+     *   writer: 要打开的视频写入器（图像序列和分段输出时不使用）
+     *   outputPath: 输出视频文件的路径
+     *   fps: 输出帧率
+     *   frameSize: 输出分辨率
+     *
+     * 返回值：
+     *   bool: 成功打开返回true
+     */
+    bool openVideoWriter(cv::VideoWriter& writer, const std::string& outputPath, double fps, cv::Size frameSize) {
+        if (options.segmentSeconds > 0.0) {
+            return openSegmentedOutput(outputPath, fps, frameSize);
+        }
+        if (hasExtension(outputPath, ".gif")) {
+            return gifOutput.open(outputPath, fps, frameSize, options.mono);
+        }
+        if (hasExtension(outputPath, ".webp")) {
+#ifdef MIKU_HAS_WEBP
+            return webpOutput.open(outputPath, fps, frameSize);
+#else
+            std::cerr << "错误: 未启用WebP支持（编译时定义MIKU_WITH_WEBP并链接libwebp）: " << outputPath << std::endl;
+            return false;
+#endif
+        }
+        if (isImageSequencePath(outputPath)) {
+            return openImageSequence(outputPath, frameSize);
+        }
+        return openEncodedVideo(writer, outputPath, fps, frameSize, videoCodecs(options.lossless));
+    }
+
+    /*
+     * 打开视频文件函数
+     * 依次尝试codecs中的编码器，直到找到当前系统可用的一个，选定的编码器记录在outputFourcc中
+     */
+    bool openEncodedVideo(cv::VideoWriter& writer, const std::string& outputPath, double fps, cv::Size frameSize,
+                          const std::vector<VideoCodecChoice>& codecs) {
+        // 灰度模式输出单通道帧，编码器按灰度视频编码
+        const bool isColor = !options.mono;
+
+        // 无损编码器不能放进MP4容器
+        if (options.lossless && hasExtension(outputPath, ".mp4")) {
+            std::cerr << "错误: 无损输出请使用 .mkv 或 .avi 容器: " << outputPath << std::endl;
+            return false;
+        }
+
+        // 尝试多种视频编码器，按顺序尝试直到找到一个可用的编码器
+        for (const auto& codec : codecs) {
+            writer.open(outputPath, codec.fourcc, fps, frameSize, isColor);
+            if (writer.isOpened()) {
+                std::cout << "使用编码器: " << codec.name << std::endl;
+                outputFourcc = codec.fourcc;
+                return true;
+            }
+        }
+
+        std::cerr << "无法创建输出视频文件: " << outputPath << std::endl;
+        return false;
+    }
+
+    // 输入预读窗口（字节）
+    size_t readaheadBytes() const {
+        return static_cast<size_t>(options.readaheadMB) << 20;
+    }
+
+    // 感知时间滤波启用时，输出整帧复用的次数
+    void reportDuplicateFrames() {
+        std::cout << (labLUT ? "感知滤波复用帧数: " : "网格无变化复用帧数: ") << duplicateFrames << std::endl;
+    }
+
+    /*
+     * 显示进度函数
+     * 每处理30帧显示一次进度
+     */
+    void reportProgress(int totalFrames) {
+        if (frameCount % 30 == 0 && totalFrames > 0) {
+            double progress = (frameCount * 100.0) / totalFrames;
+            std::cout << "进度: " << frameCount << "/" << totalFrames
+            << " 帧 (" << std::fixed << std::setprecision(1) << progress << "%)" << std::endl;
+        }
+    }
+
+    /*
+     * 字形图集准备函数
+     * 未指定字体时用Hershey字体建立图集；指定字体时用FreeType光栅化（或读取缓存）
+     */
+    bool prepareAtlas() {
+        bool built = options.fontPath.empty()
+            ? atlas.loadEmbedded(currentCharset, glyphSpan) || atlas.build(glyphCodepoints, glyphSpan)
+            : atlas.buildFromFont(glyphCodepoints, glyphSpan, options.fontPath, options.fontPixelSize, options.fontBold);
+        if (built && options.coverageCompensation) {
+            rebuildGlyphGains();
+        }
+        if (built && options.roiEnabled) {
+            atlas.buildScaled(ASCIIVideoConstants::ROI_COARSE_FACTOR);
+        }
+        return built;
+    }
+
+    /*
+     * 准备网格文件解码用的字形图集函数
+     * 网格文件头保存了转换时绘制的图集，直接使用，解码时不需要再指定 --font
+     */
+    bool prepareGridAtlas(const GridFileHeader& header) {
+        if (!atlas.loadTiles(glyphSpan, header.tileWidth, header.glyphAlpha, static_cast<int>(glyphCodepoints.size()))) {
+            std::cerr << "错误: 字符网格文件中的字形图集与字符集不符" << std::endl;
+            return false;
+        }
+        if (options.coverageCompensation) {
+            rebuildGlyphGains();
+        }
+        return true;
+    }
+
+    /*
+     * 覆盖率补偿增益表函数
+     * 字符格的视觉亮度约为 颜色 x 字形覆盖率；以覆盖率最高的字形为基准，
+     * 每个字形的增益 = 最高覆盖率 / 本字形覆盖率，限制在 [1, COVERAGE_MAX_GAIN]，
+     * 渲染时每格只需按查表得到的增益缩放一次颜色
+     */
+    void rebuildGlyphGains() {
+        double maxCoverage = 0.0;
+        for (int i = 0; i < atlas.glyphCount(); ++i) {
+            maxCoverage = std::max(maxCoverage, atlas.coverage(i));
+        }
+        for (int i = 0; i < atlas.glyphCount(); ++i) {
+            double c = atlas.coverage(i);
+            double gain = c > 0.0 ? std::clamp(maxCoverage / c, 1.0, ASCIIVideoConstants::COVERAGE_MAX_GAIN) : 1.0;
+            glyphGain[i] = static_cast<uint16_t>(std::lround(gain * 256.0));
+        }
+    }
+
+    // 按字形增益缩放颜色（饱和到255）
+    cv::Vec3b compensateColor(const cv::Vec3b& color, int glyph) const {
+        const int gain = glyphGain[glyph];
+        return cv::Vec3b(static_cast<uchar>(std::min(255, (color[0] * gain) >> 8)),
+                         static_cast<uchar>(std::min(255, (color[1] * gain) >> 8)),
+                         static_cast<uchar>(std::min(255, (color[2] * gain) >> 8)));
+    }
+
+    // 按字形增益缩放灰度（灰度模式，与彩色模式的compensateColor对应）
+    uchar compensateLevel(int level, int glyph) const {
+        return static_cast<uchar>(std::min(255, (level * glyphGain[glyph]) >> 8));
+    }
+
+    // 第glyph个字形的UTF-8文本
+    std::string glyphText(int glyph) const {
+        return encodeUTF8(glyphCodepoints[glyph]);
+    }
+
+    /*
+     * 测试字符显示函数
+     * 显示当前使用的字符集及其亮度映射关系
+     *
+     * 作用：
+     *   1. 让用户了解使用哪些字符进行转换
+     *   2. 显示字符的亮度映射关系，帮助理解字符选择逻辑
+     *   3. 调试目的：验证字符集是否正确加载
+     */
+    void testCharacterDisplay() {
+        std::cout << "测试字符显示:" << std::endl;
+        std::cout << "基本字符集: " << currentCharset << std::endl;
+        std::cout << "字符数量: " << glyphCodepoints.size() << std::endl;
+
+        std::cout << "字符亮度映射:" << std::endl;
+
+        // 遍历字符集中的每个字符
+        for (size_t i = 0; i < glyphCodepoints.size(); ++i) {
+            // 计算字符对应的亮度值
+            // 假设字符在字符集中的位置线性对应亮度
+            // 第一个字符对应亮度0（最暗），最后一个字符对应亮度1（最亮）
+            double brightness = static_cast<double>(i) / std::max<size_t>(1, glyphCodepoints.size() - 1);
+
+            // 格式化输出字符和对应的亮度值
+            std::cout << "'" << glyphText(static_cast<int>(i)) << "' -> " << std::fixed << std::setprecision(2) << brightness;
+
+            // 每显示8个字符换行一次，使输出更整洁
+            if (i % 8 == 7) {
+                std::cout << std::endl;
+            } else {
+                std::cout << " | ";
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    /*
+     * 渲染帧函数
+     * 先把采样网格分析为字符网格（字形编号和颜色平面），再按输出模式渲染；
+     * 字符网格与上一帧完全相同时直接复用上一帧输出
+     * glyphBand非空时为批量分析已查好的本帧字形（与sampledFrame同尺寸的单通道图像）
+     */
+    cv::Mat renderFrame(const cv::Mat& sampledFrame, int samples, const cv::Mat& glyphBand = cv::Mat()) {
+        // 隔行更新：首帧完整渲染，之后每帧只渲染一组轮换的字符行
+        if (options.interlace > 1 && !interlacedFrame.empty()) {
+            rowStep = options.interlace;
+            rowPhase = frameCount % options.interlace;
+        }
+
+        // 感知时间滤波：先得到每格颜色并在Lab空间做迟滞，变化不可感知的字符格保持原颜色
+        cv::Mat filteredCells;
+        if (labLUT) {
+            collapseSamples(sampledFrame, samples, filteredCells);
+            applyPerceptualHysteresis(filteredCells);
+            samples = 1;
+        }
+        const cv::Mat& cells = labLUT ? filteredCells : sampledFrame;
+
+        // 分析：得到本帧字符网格，帧结束时用本帧直方图更新下一帧的色阶
+        // 批量模式已整批查好字形时只需把颜色和字形拷贝进网格平面
+        if (!glyphBand.empty()) {
+            fillGridFromBatch(cells, glyphBand, frameGrid);
+        } else {
+            analyseGrid(cells, samples, frameGrid);
+        }
+        updateAutoLevels();
+
+        // 所有字符格的字形和颜色都与上一帧相同时直接复用上一帧，跳过绘制
+        int changedCells = frameGrid.markChanges(previousGrid);
+        previousGrid.copyFrom(frameGrid);
+        if (changedCells == 0 && !lastAsciiFrame.empty()) {
+            duplicateFrames++;
+            return lastAsciiFrame;
+        }
+
+        cv::Mat asciiFrame;
+        if (options.mono) {
+            asciiFrame = generateMonoASCIIFrame(frameGrid);
+        } else if (options.backgroundFill) {
+            asciiFrame = generateBackgroundFillFrame(frameGrid);
+        } else {
+            asciiFrame = generateColorASCIIFrame(frameGrid);
+        }
+
+        lastAsciiFrame = asciiFrame;  // 供下一帧整帧复用
+        return asciiFrame;
+    }
+
+    /*
+     * 字符网格分析函数
+     * 对每个字符格求平均颜色（超采样时合并采样点）、计算亮度、查表选择字形，
+     * 结果写入字符网格的字形编号和B、G、R平面；隔行更新模式只分析本帧的行
+     *
+     * 参数：
+     *   cells: 分析阶段输出的网格图像（超采样时为samples倍）
+     *   samples: 每个字符格每个方向的采样数
+     *   grid: 输出的字符网格（跨帧保留，尺寸不变时未分析的行保持原值）
+     *
+     * 背景填充模式的字形按对比方向选择：暗格子按亮度、亮格子按反转亮度
+     */
+    void analyseGrid(const cv::Mat& cells, int samples, AsciiGrid& grid) {
+        const int width = cells.cols / samples;
+        const int height = cells.rows / samples;
+        grid.resize(width, height);
+
+        for (int y = rowPhase; y < height; y += rowStep) {
+            uchar* glyphs = grid.row(AsciiGrid::GLYPH, y);
+            uchar* blue = grid.row(AsciiGrid::BLUE, y);
+            uchar* green = grid.row(AsciiGrid::GREEN, y);
+            uchar* red = grid.row(AsciiGrid::RED, y);
+            for (int x = 0; x < width; x++) {
+                // 超采样时在同一循环内求采样点平均，不需要额外遍历
+                cv::Vec3b pixel = samples == 1 ? cells.at<cv::Vec3b>(y, x)
+                                               : averageSamples(cells, x, y, samples, linearLUT);
+
+                // 计算像素亮度（0-255）：亮度 = 0.299*R + 0.587*G + 0.114*B（8位定点整数运算）
+                int luma = computeLuma(pixel);
+
+                // 根据亮度查表选择对应的字形（同时累计自动色阶直方图）
+                int glyphLuma = options.backgroundFill && luma >= 128 ? 255 - luma : luma;
+                int glyph = lookupGlyph(glyphLuma);
+
+                glyphs[x] = static_cast<uchar>(glyph);
+                blue[x] = pixel[0];
+                green[x] = pixel[1];
+                red[x] = pixel[2];
+
+                // 调试输出：只在第一帧的前6个像素显示亮度到字符的映射关系
+                // 帮助理解字符选择过程，实际运行时只执行一次
+                if (x < 3 && y < 2 && frameCount == 0) {
+                    std::cout << "像素(" << x << "," << y << "): 亮度=" << std::fixed
+                    << std::setprecision(3) << luma / 255.0 << ", 字符='"
+                    << glyphText(glyph) << "'" << std::endl;
+                }
+            }
+        }
+    }
+
+    /*
+     * 批量分析函数
+     * 读入最多 batchFrames 帧，把各帧的缩放（线性光模式含查找表转换）分配到OpenCV线程池并行执行，
+     * 结果写入一块连续的 (K x 网格高) x 网格宽 图像，第k帧占第k个行带
+     *
+     * 小网格（如80x22）逐帧处理时，每帧的工作量不足以填满线程池和向量单元，
+     * 按批处理后并行粒度变为整帧，每批只同步一次
+     *
+     * 字形查找不依赖前后帧时（未启用自动色阶和感知滤波），同一并行任务中紧接着为每帧查好字形，
+     * 写入同样布局的单通道图像glyphs；否则glyphs为空，字形仍在渲染时按帧顺序查找
+     * （自动色阶的查找表由上一帧的直方图决定，感知滤波依赖上一帧的颜色）
+     *
+     * 参数：
+     *   cap: 视频输入
+     *   frames: 本批原始帧（复用缓冲区）
+     *   contentRect: 内容区域（裁剪）
+     *   sampleSize: 每帧采样网格大小
+     *   batch: 输出的连续缩放结果
+     *   glyphs: 输出的连续字形编号（可能为空）
+     *
+     * 返回值：
+     *   int: 本批实际读入的帧数，0表示视频已结束
+     */
+    int analyseBatch(cv::VideoCapture& cap, std::vector<cv::Mat>& frames, const cv::Rect& contentRect,
+                     const cv::Size& sampleSize, cv::Mat& batch, cv::Mat& glyphs) {
+        int count = 0;
+        while (count < static_cast<int>(frames.size()) && cap.read(frames[count])) {
+            count++;
+        }
+        if (count == 0) {
+            return 0;
+        }
+
+        batch.create(sampleSize.height * static_cast<int>(frames.size()), sampleSize.width, CV_8UC3);
+        const bool lookupGlyphs = !options.autoLevels && !labLUT;
+        if (lookupGlyphs) {
+            glyphs.create(batch.size(), CV_8UC1);
+        } else {
+            glyphs.release();
+        }
+        cv::parallel_for_(cv::Range(0, count), [&](const cv::Range& range) {
+            cv::Mat linearFrame, linearResized;
+            for (int k = range.start; k < range.end; ++k) {
+                // 目标是批次图像中的行带，尺寸和类型一致，缩放结果直接写入，不再拷贝
+                cv::Mat band = batch.rowRange(k * sampleSize.height, (k + 1) * sampleSize.height);
+                if (linearLUT) {
+                    cv::LUT(frames[k](contentRect), linearLUT->toLinearMat, linearFrame);
+                    cv::resize(linearFrame, linearResized, sampleSize, 0, 0, cv::INTER_AREA);
+                    linearLUT->linearToSRGB(linearResized, band);
+                } else {
+                    cv::resize(frames[k](contentRect), band, sampleSize, 0, 0, cv::INTER_AREA);
+                }
+                if (lookupGlyphs) {
+                    lookupBandGlyphs(band, glyphs.rowRange(k * sampleSize.height, (k + 1) * sampleSize.height));
+                }
+            }
+        });
+        return count;
+    }
+
+    /*
+     * 行带字形查找函数
+     * 对一帧的网格图像逐格计算亮度并查表得到字形编号（背景填充模式亮格子按反转亮度），
+     * 只读取字形查找表，可在线程池中并行调用
+     */
+    void lookupBandGlyphs(const cv::Mat& cells, cv::Mat glyphs) const {
+        for (int y = 0; y < cells.rows; ++y) {
+            const cv::Vec3b* pixel = cells.ptr<cv::Vec3b>(y);
+            uchar* out = glyphs.ptr<uchar>(y);
+            for (int x = 0; x < cells.cols; ++x) {
+                int luma = computeLuma(pixel[x]);
+                out[x] = glyphLut[options.backgroundFill && luma >= 128 ? 255 - luma : luma];
+            }
+        }
+    }
+
+    /*
+     * 批量结果填充函数
+     * 把批量分析得到的本帧颜色和字形逐行拆分到字符网格的平面中
+     */
+    void fillGridFromBatch(const cv::Mat& cells, const cv::Mat& glyphBand, AsciiGrid& grid) {
+        grid.resize(cells.cols, cells.rows);
+        for (int y = 0; y < cells.rows; ++y) {
+            const cv::Vec3b* pixel = cells.ptr<cv::Vec3b>(y);
+            std::memcpy(grid.row(AsciiGrid::GLYPH, y), glyphBand.ptr<uchar>(y), cells.cols);
+            uchar* blue = grid.row(AsciiGrid::BLUE, y);
+            uchar* green = grid.row(AsciiGrid::GREEN, y);
+            uchar* red = grid.row(AsciiGrid::RED, y);
+            for (int x = 0; x < cells.cols; ++x) {
+                blue[x] = pixel[x][0];
+                green[x] = pixel[x][1];
+                red[x] = pixel[x][2];
+            }
+        }
+    }
+
+    /*
+     * 隔行分析函数
+     * 只把本帧要更新的字符行对应的源画面条带缩放到采样网格中对应的行，
+     * 其余行保留之前的分析结果；首帧（或网格大小变化时）完整缩放
+     *
+     * 参数：
+     *   source: 源画面（已裁剪）
+     *   sampleSize: 采样网格大小
+     *   samples: 每个字符格每个方向的采样数
+     *   grid: 跨帧保留的采样网格
+     */
+    void analyseInterlacedRows(const cv::Mat& source, const cv::Size& sampleSize, int samples, cv::Mat& grid) {
+        cv::Mat linearStripe, linearRow;
+        auto resizeArea = [this, &linearStripe, &linearRow](const cv::Mat& src, cv::Mat& dst, const cv::Size& size) {
+            if (linearLUT) {
+                cv::LUT(src, linearLUT->toLinearMat, linearStripe);
+                cv::resize(linearStripe, linearRow, size, 0, 0, cv::INTER_AREA);
+                linearLUT->linearToSRGB(linearRow, dst);
+            } else {
+                cv::resize(src, dst, size, 0, 0, cv::INTER_AREA);
+            }
+        };
+
+        if (grid.size() != sampleSize) {
+            resizeArea(source, grid, sampleSize);
+            return;
+        }
+
+        const int gridRows = sampleSize.height / samples;
+        const int phase = frameCount % options.interlace;
+        cv::Mat rowCells;
+        for (int row = phase; row < gridRows; row += options.interlace) {
+            int y0 = row * source.rows / gridRows;
+            int y1 = std::max(y0 + 1, (row + 1) * source.rows / gridRows);
+            resizeArea(source.rowRange(y0, y1), rowCells, cv::Size(sampleSize.width, samples));
+            rowCells.copyTo(grid.rowRange(row * samples, (row + 1) * samples));
+        }
+    }
+
+    /*
+     * 输出帧分配函数
+     * 普通模式每帧新建输出帧；隔行更新模式返回跨帧保留的输出帧，并只清空本帧要重画的字符行
+     *
+     * 参数：
+     *   rows, cols, type: 输出帧尺寸和类型
+     *   clear: 是否清为黑色（背景填充模式会覆盖每个像素，不需要清空）
+     */
+    cv::Mat beginOutputFrame(int rows, int cols, int type, bool clear) {
+        if (options.interlace <= 1) {
+            return clear ? cv::Mat(rows, cols, type, cv::Scalar::all(0)) : cv::Mat(rows, cols, type);
+        }
+        if (interlacedFrame.empty()) {
+            interlacedFrame.create(rows, cols, type);
+        }
+        if (clear) {
+            const int cellHeight = ASCIIVideoConstants::ASCII_CHAR_HEIGHT;
+            for (int y = rowPhase; y < rows / cellHeight; y += rowStep) {
+                interlacedFrame.rowRange(y * cellHeight, (y + 1) * cellHeight).setTo(cv::Scalar::all(0));
+            }
+        }
+        return interlacedFrame;
+    }
+
+    /*
+     * 生成背景填充ASCII帧函数
+     * 每个字符格先填满平均颜色，再以对比色叠加字符：
+     *   暗格子叠加提亮的字符，字符密度随亮度增加；亮格子叠加变暗的字符，字符密度随亮度降低
+     * 字符格是平坦色块，编码后的文件也更小
+     *
+     * 填充方式：每个字符行先拼出一条像素行（每格颜色重复字形宽度次），
+     * 再整行memcpy到该字符行的全部像素行，填充是连续内存拷贝
+     */
+    cv::Mat generateBackgroundFillFrame(const AsciiGrid& grid) {
+        const int width = grid.getWidth();
+        const int height = grid.getHeight();
+        const int cw = atlas.cellWidth();
+        const int chh = ASCIIVideoConstants::ASCII_CHAR_HEIGHT;
+        const int contrast = ASCIIVideoConstants::BACKGROUND_GLYPH_CONTRAST;
+
+        cv::Mat asciiFrame = beginOutputFrame(height * chh, width * cw, CV_8UC3, false);
+        const size_t rowBytes = static_cast<size_t>(width) * cw * 3;
+
+        for (int y = rowPhase; y < height; y += rowStep) {
+            const uchar* glyphs = grid.row(AsciiGrid::GLYPH, y);
+            const uchar* blue = grid.row(AsciiGrid::BLUE, y);
+            const uchar* green = grid.row(AsciiGrid::GREEN, y);
+            const uchar* red = grid.row(AsciiGrid::RED, y);
+
+            // 拼出本字符行的第一条像素行
+            uchar* firstRow = asciiFrame.ptr<uchar>(y * chh);
+            for (int x = 0; x < width; x++) {
+                uchar* cell = firstRow + x * cw * 3;
+                for (int i = 0; i < cw; ++i) {
+                    cell[i * 3] = blue[x];
+                    cell[i * 3 + 1] = green[x];
+                    cell[i * 3 + 2] = red[x];
+                }
+            }
+            for (int row = 1; row < chh; ++row) {
+                std::memcpy(asciiFrame.ptr<uchar>(y * chh + row), firstRow, rowBytes);
+            }
+
+            if (!options.backgroundGlyphs) {
+                continue;
+            }
+
+            // 叠加对比色字符（整行背景填好后再画，伸出字符格的笔画混合在相邻背景上）
+            for (int x = 0; x < width; x++) {
+                const cv::Vec3b bg(blue[x], green[x], red[x]);
+                bool bright = computeLuma(bg) >= 128;
+
+                cv::Vec3b fg;
+                for (int ch = 0; ch < 3; ++ch) {
+                    fg[ch] = bright ? static_cast<uchar>(bg[ch] * (255 - contrast) / 255)
+                                    : static_cast<uchar>(bg[ch] + (255 - bg[ch]) * contrast / 255);
+                }
+                atlas.blitBlend(asciiFrame, x, y, glyphs[x], fg);
+            }
+        }
+
+        return asciiFrame;
+    }
+
+    /*
+     * 生成灰度ASCII帧函数
+     * 灰度快速路径：每格只计算亮度，单通道字形图块绘制到CV_8UC1输出帧，
+     * 渲染和编码的数据量都只有彩色模式的三分之一
+     *
+     * 参数：
+     *   grid: 本帧字符网格
+     *
+     * 返回值：
+     *   cv::Mat: CV_8UC1的ASCII艺术帧，字符灰度等于字符格亮度
+     */
+    cv::Mat generateMonoASCIIFrame(const AsciiGrid& grid) {
+        const int width = grid.getWidth();
+        const int height = grid.getHeight();
+
+        cv::Mat asciiFrame = beginOutputFrame(height * ASCIIVideoConstants::ASCII_CHAR_HEIGHT,
+                                              width * atlas.cellWidth(), CV_8UC1, true);
+
+        for (int y = rowPhase; y < height; y += rowStep) {
+            const uchar* glyphs = grid.row(AsciiGrid::GLYPH, y);
+            const uchar* blue = grid.row(AsciiGrid::BLUE, y);
+            const uchar* green = grid.row(AsciiGrid::GREEN, y);
+            const uchar* red = grid.row(AsciiGrid::RED, y);
+            for (int x = 0; x < width; x++) {
+                int luma = computeLuma(cv::Vec3b(blue[x], green[x], red[x]));
+                int glyph = glyphs[x];
+                atlas.blitMono(asciiFrame, x, y, glyph, options.coverageCompensation ? compensateLevel(luma, glyph)
+                                                                                     : static_cast<uchar>(luma));
+            }
+        }
+
+        return asciiFrame;
+    }
+
+    /*
+     * 生成彩色ASCII帧函数
+     * 将彩色图像帧转换为ASCII艺术图像帧
+     *
+     * 参数：
+     *   grid: 本帧字符网格（分析阶段已选好每格的字形和颜色）
+     *
+     * 返回值：
+     *   cv::Mat: 包含ASCII字符的彩色图像帧
+     *
+     * 工作原理：
+     *   1. 创建黑色背景图像
+     *   2. 遍历字符网格的每个字符格，读取字形编号和颜色平面
+     *   3. 使用字符格颜色绘制字形
+     */
+    cv::Mat generateColorASCIIFrame(const AsciiGrid& grid) {
+        // 获取ASCII网格尺寸
+        int width = grid.getWidth();    // 列数 = ASCII宽度
+        int height = grid.getHeight();  // 行数 = ASCII高度
+
+        // 创建输出图像（ASCII艺术帧）
+        // 尺寸：每个ASCII字符占据固定像素大小
+        // 类型：CV_8UC3 表示8位无符号整数，3通道（BGR彩色图像）
+        // 初始颜色：黑色背景（隔行更新模式只清空本帧要重画的行）
+        cv::Mat asciiFrame = beginOutputFrame(height * ASCIIVideoConstants::ASCII_CHAR_HEIGHT,
+                                              width * atlas.cellWidth(), CV_8UC3, true);
+
+        // 双重循环遍历ASCII网格中的每个位置（隔行更新模式只遍历本帧的行）
+        for (int y = rowPhase; y < height; y += rowStep) {  // 行循环
+            const uchar* glyphs = grid.row(AsciiGrid::GLYPH, y);
+            const uchar* blue = grid.row(AsciiGrid::BLUE, y);
+            const uchar* green = grid.row(AsciiGrid::GREEN, y);
+            const uchar* red = grid.row(AsciiGrid::RED, y);
+            for (int x = 0; x < width; x++) {      // 列循环
+                int glyph = glyphs[x];
+                cv::Vec3b pixel(blue[x], green[x], red[x]);
+
+                // 使用字符格颜色作为字符颜色（覆盖率补偿时按字形增益提亮），从字形图集绘制到字符格
+                // 字形在启动时已用putText（FONT_HERSHEY_SIMPLEX、抗锯齿）绘制好，这里只做缩放拷贝
+                atlas.blitColor(asciiFrame, x, y, glyph, options.coverageCompensation ? compensateColor(pixel, glyph) : pixel);
+            }
+        }
+
+        return asciiFrame;  // 返回生成的ASCII艺术帧
+    }
+
+    /*
+     * 合并采样点函数
+     * 把超采样网格求平均得到每个字符格的颜色；未超采样时直接拷贝
+     */
+    void collapseSamples(const cv::Mat& sampledFrame, int samples, cv::Mat& cells) const {
+        if (samples == 1) {
+            sampledFrame.copyTo(cells);
+            return;
+        }
+        cells.create(sampledFrame.rows / samples, sampledFrame.cols / samples, CV_8UC3);
+        for (int y = 0; y < cells.rows; ++y) {
+            cv::Vec3b* out = cells.ptr<cv::Vec3b>(y);
+            for (int x = 0; x < cells.cols; ++x) {
+                out[x] = averageSamples(sampledFrame, x, y, samples, linearLUT);
+            }
+        }
+    }
+
+    /*
+     * 感知迟滞函数
+     * 逐字符格比较新颜色与保持颜色的ΔE（Lab距离）：
+     *   小于阈值        -> 保持原颜色（字符也随之保持），消除噪声引起的闪烁
+     *   阈值到两倍阈值   -> 在Lab空间取中点再转回BGR，平滑缓慢变化
+     *   超过两倍阈值     -> 直接采用新颜色
+     * 每格只需一次正向查表，折中时再加一次反向查表
+     *
+     * 参数：
+     *   cells: 字符格颜色网格，就地替换为滤波后的颜色
+     *
+     * 返回值：
+     *   int: 颜色发生变化的字符格数量
+     */
+    int applyPerceptualHysteresis(cv::Mat& cells) {
+        const int total = cells.rows * cells.cols;
+        if (heldColors.size() != cells.size()) {
+            // 第一帧或网格尺寸变化：全部采用新颜色
+            cells.copyTo(heldColors);
+            heldLab.resize(static_cast<size_t>(total) * 3);
+            for (int i = 0; i < total; ++i) {
+                labLUT->toLab(cells.at<cv::Vec3b>(i / cells.cols, i % cells.cols), &heldLab[i * 3]);
+            }
+            return total;
+        }
+
+        const double threshold = options.hysteresisDeltaE * ASCIIVideoConstants::LAB_FIXED_SCALE;
+        const int holdLimit = static_cast<int>(threshold * threshold);
+        const int blendLimit = holdLimit * 4;  // (2 * 阈值)^2
+        int changed = 0;
+
+        for (int y = 0; y < cells.rows; ++y) {
+            cv::Vec3b* row = cells.ptr<cv::Vec3b>(y);
+            cv::Vec3b* held = heldColors.ptr<cv::Vec3b>(y);
+            for (int x = 0; x < cells.cols; ++x) {
+                int* heldValue = &heldLab[(y * cells.cols + x) * 3];
+                int lab[3];
+                labLUT->toLab(row[x], lab);
+                int distance = LabColorLUT::distanceSquared(lab, heldValue);
+
+                if (distance < holdLimit) {
+                    row[x] = held[x];
+                    continue;
+                }
+                if (distance < blendLimit) {
+                    for (int ch = 0; ch < 3; ++ch) {
+                        lab[ch] = (lab[ch] + heldValue[ch]) / 2;
+                    }
+                    row[x] = labLUT->toBGR(lab);
+                }
+                held[x] = row[x];
+                std::copy(lab, lab + 3, heldValue);
+                changed++;
+            }
+        }
+        return changed;
+    }
+
+    /*
+     * 采样点平均函数
+     * 求字符格 (x, y) 对应的 samples x samples 个采样点的平均颜色（整数运算，四舍五入）
+     * 启用线性光时采样点先查表转为线性光，平均后再转回sRGB
+     */
+    static cv::Vec3b averageSamples(const cv::Mat& sampleGrid, int x, int y, int samples,
+                                    const LinearLightLUT* linear) {
+        int sum[3] = {0, 0, 0};
+        for (int sy = 0; sy < samples; ++sy) {
+            const cv::Vec3b* row = sampleGrid.ptr<cv::Vec3b>(y * samples + sy) + x * samples;
+            for (int sx = 0; sx < samples; ++sx) {
+                for (int ch = 0; ch < 3; ++ch) {
+                    sum[ch] += linear ? linear->toLinear[row[sx][ch]] : row[sx][ch];
+                }
+            }
+        }
+
+        int count = samples * samples;
+        cv::Vec3b mean;
+        for (int ch = 0; ch < 3; ++ch) {
+            int value = (sum[ch] + count / 2) / count;
+            mean[ch] = linear ? linear->toSRGB[value] : static_cast<uchar>(value);
+        }
+        return mean;
+    }
+
+    /*
+     * 计算兴趣区域对应的字符格范围
+     * 将原始视频坐标下的兴趣区域换算到网格坐标，并向外扩展到粗格边界，
+     * 使每个外围粗格要么完全在区域内、要么完全在区域外
+     *
+     * 参数：
+     *   contentRect: 当前内容区域（原始视频像素坐标）
+     *   gridWidth, gridHeight: 网格尺寸（字符数）
+     *
+     * 返回值：
+     *   cv::Rect: 兴趣区域覆盖的字符格范围，可能为空（区域在内容之外）
+     */
+    cv::Rect computeROICells(const cv::Rect& contentRect, int gridWidth, int gridHeight) {
+        cv::Rect roi = options.roi;
+        if (options.roiCenter) {
+            roi = cv::Rect(contentRect.x + contentRect.width / 4, contentRect.y + contentRect.height / 4,
+                           contentRect.width / 2, contentRect.height / 2);
+        }
+        roi = roi & contentRect;
+        if (roi.area() == 0) {
+            return cv::Rect();
+        }
 
-        std::cout << "转换完成! 总帧数: " << frameCount << std::endl;
-        std::cout << "输出文件: " << outputPath << std::endl;
-        return true;  // 转换成功
-                             }
+        const int factor = ASCIIVideoConstants::ROI_COARSE_FACTOR;
+        int x0 = (roi.x - contentRect.x) * gridWidth / contentRect.width;
+        int y0 = (roi.y - contentRect.y) * gridHeight / contentRect.height;
+        int x1 = ((roi.x + roi.width - contentRect.x) * gridWidth + contentRect.width - 1) / contentRect.width;
+        int y1 = ((roi.y + roi.height - contentRect.y) * gridHeight + contentRect.height - 1) / contentRect.height;
+
+        x0 = x0 / factor * factor;
+        y0 = y0 / factor * factor;
+        x1 = std::min(gridWidth, (x1 + factor - 1) / factor * factor);
+        y1 = std::min(gridHeight, (y1 + factor - 1) / factor * factor);
+        return cv::Rect(x0, y0, x1 - x0, y1 - y0);
+    }
 
-private:
     /*
-     * 测试字符显示函数
-     * 显示当前使用的字符集及其亮度映射关系
+     * 生成可变密度ASCII帧函数
+     * 兴趣区域内每个字符格正常绘制，区域外每 ROI_COARSE_FACTOR x ROI_COARSE_FACTOR
+     * 个字符格合并为一个放大的字符
      *
-     * 作用：
-     *   1. 让用户了解使用哪些字符进行转换
-     *   2. 显示字符的亮度映射关系，帮助理解字符选择逻辑
-     *   3. 调试目的：验证字符集是否正确加载
+     * 参数：
+     *   gridWidth, gridHeight: 普通密度下的网格尺寸
+     *   roiCells: 兴趣区域覆盖的字符格范围（已对齐粗格边界）
+     *
+     * 工作原理：
+     *   使用本帧已建好的积分图（areaTable），任意大小格子的平均颜色都只需读取四个角点，
+     *   不同大小的格子共用同一次遍历，成本为每格O(1)
      */
-    void testCharacterDisplay() {
-        std::cout << "测试字符显示:" << std::endl;
-        std::cout << "基本字符集: " << currentCharset << std::endl;
-        std::cout << "字符数量: " << currentCharset.length() << std::endl;
+    cv::Mat generateVariableDensityFrame(int gridWidth, int gridHeight, const cv::Rect& roiCells) {
+        cv::Mat asciiFrame(gridHeight * ASCIIVideoConstants::ASCII_CHAR_HEIGHT, gridWidth * atlas.cellWidth(),
+                           CV_8UC3, cv::Scalar(0, 0, 0));
 
-        std::cout << "字符亮度映射:" << std::endl;
+        // 字符格 (cx, cy) 到源图像像素范围的映射，与均匀网格的划分方式一致
+        const int sourceWidth = areaTable.getWidth();
+        const int sourceHeight = areaTable.getHeight();
+        auto cellMean = [&](int cx0, int cy0, int cx1, int cy1) {
+            int x0 = cx0 * sourceWidth / gridWidth;
+            int x1 = std::max(x0 + 1, cx1 * sourceWidth / gridWidth);
+            int y0 = cy0 * sourceHeight / gridHeight;
+            int y1 = std::max(y0 + 1, cy1 * sourceHeight / gridHeight);
+            return areaTable.cellMean(x0, y0, x1, y1);
+        };
 
-        // 遍历字符集中的每个字符
-        for (size_t i = 0; i < currentCharset.length(); ++i) {
-            // 计算字符对应的亮度值
-            // 假设字符在字符集中的位置线性对应亮度
-            // 第一个字符对应亮度0（最暗），最后一个字符对应亮度1（最亮）
-            double brightness = static_cast<double>(i) / (currentCharset.length() - 1);
+        const int factor = ASCIIVideoConstants::ROI_COARSE_FACTOR;
+        for (int by = 0; by < gridHeight; by += factor) {
+            for (int bx = 0; bx < gridWidth; bx += factor) {
+                bool inside = bx >= roiCells.x && bx < roiCells.x + roiCells.width &&
+                              by >= roiCells.y && by < roiCells.y + roiCells.height;
+                bool complete = bx + factor <= gridWidth && by + factor <= gridHeight;
 
-            // 格式化输出字符和对应的亮度值
-            std::cout << "'" << currentCharset[i] << "' -> " << std::fixed << std::setprecision(2) << brightness;
+                if (!inside && complete) {
+                    // 外围：整个粗格只计算一次平均值，绘制一个放大的字符
+                    drawCell(asciiFrame, bx, by, factor, cellMean(bx, by, bx + factor, by + factor));
+                    continue;
+                }
 
-            // 每显示8个字符换行一次，使输出更整洁
-            if (i % 8 == 7) {
-                std::cout << std::endl;
-            } else {
-                std::cout << " | ";
+                // 兴趣区域内（或网格边缘不完整的粗格）：逐个普通字符格绘制
+                for (int cy = by; cy < std::min(by + factor, gridHeight); ++cy) {
+                    for (int cx = bx; cx < std::min(bx + factor, gridWidth); ++cx) {
+                        drawCell(asciiFrame, cx, cy, 1, cellMean(cx, cy, cx + 1, cy + 1));
+                    }
+                }
             }
         }
-        std::cout << std::endl;
+
+        updateAutoLevels();
+        return asciiFrame;
     }
 
     /*
-     * 生成彩色ASCII帧函数
-     * 将彩色图像帧转换为ASCII艺术图像帧
+     * 绘制单个字符格函数
+     * 根据颜色亮度选择字符，并以该颜色绘制到指定字符格
      *
      * 参数：
-     *   colorFrame: 输入彩色图像帧（已调整到ASCII网格大小）
+     *   asciiFrame: 输出图像
+     *   cellX, cellY: 字符格左上角位置（普通字符格坐标）
+     *   cellScale: 字符格放大倍数，1表示普通字符格
+     *   cellColor: 字符格的平均颜色（BGR），启用覆盖率补偿时按字形增益提亮后绘制
+     */
+    void drawCell(cv::Mat& asciiFrame, int cellX, int cellY, int cellScale, const cv::Vec3b& cellColor) {
+        int glyph = lookupGlyph(computeLuma(cellColor));
+        const cv::Vec3b pixel = options.coverageCompensation ? compensateColor(cellColor, glyph) : cellColor;
+        if (cellScale == 1) {
+            atlas.blitColor(asciiFrame, cellX, cellY, glyph, pixel);
+            return;
+        }
+
+        // 放大的字符格使用启动时放大好的图块（prepareAtlas中建立）
+        atlas.blitScaledColor(asciiFrame, cellX, cellY, cellScale, glyph, pixel);
+    }
+
+    /*
+     * 整数亮度计算函数
+     * 亮度 = (77*R + 150*G + 29*B + 128) / 256，结果范围0-255
+     */
+    static int computeLuma(const cv::Vec3b& pixel) {
+        return (ASCIIVideoConstants::RED_WEIGHT_Q8 * pixel[2] +
+                ASCIIVideoConstants::GREEN_WEIGHT_Q8 * pixel[1] +
+                ASCIIVideoConstants::BLUE_WEIGHT_Q8 * pixel[0] + 128) >> 8;
+    }
+
+    /*
+     * 查表选择字形函数
+     * 启用自动色阶时顺便把亮度计入直方图，直方图在字符生成的同一次遍历中建立
      *
      * 返回值：
-     *   cv::Mat: 包含ASCII字符的彩色图像帧
-     *
-     * 工作原理：
-     *   1. 创建黑色背景图像
-     *   2. 遍历输入图像的每个像素
-     *   3. 计算像素亮度
-     *   4. 根据亮度选择ASCII字符
-     *   5. 使用像素原始颜色绘制字符
+     *   int: 字形编号（字符在字符集中的位置）
      */
-    cv::Mat generateColorASCIIFrame(const cv::Mat& colorFrame) {
-        // 获取输入图像的尺寸（ASCII网格尺寸）
-        int width = colorFrame.cols;   // 列数 = ASCII宽度
-        int height = colorFrame.rows;  // 行数 = ASCII高度
+    int lookupGlyph(int luma) {
+        if (options.autoLevels) {
+            lumaHistogram[luma]++;
+        }
+        return glyphLut[luma];
+    }
 
-        // 创建输出图像（ASCII艺术帧）
-        // 尺寸：每个ASCII字符占据固定像素大小
-        // 类型：CV_8UC3 表示8位无符号整数，3通道（BGR彩色图像）
-        // 初始颜色：黑色背景（Scalar(0, 0, 0)）
-        cv::Mat asciiFrame(height * ASCIIVideoConstants::ASCII_CHAR_HEIGHT,
-                           width * ASCIIVideoConstants::ASCII_CHAR_WIDTH,
-                           CV_8UC3, cv::Scalar(0, 0, 0));
+    /*
+     * 重建亮度到字符查找表函数
+     * 亮度先按当前黑位、白位线性拉伸到[0, 1]，再映射到字符
+     * 未启用自动色阶时黑位为0、白位为255，与直接映射完全相同
+     */
+    void rebuildGlyphLut() {
+        double range = std::max(1.0, levelHigh - levelLow);
+        for (int luma = 0; luma < 256; ++luma) {
+            glyphLut[luma] = static_cast<uchar>(getGlyphIndex((luma - levelLow) / range));
+        }
+    }
 
-        // 双重循环遍历ASCII网格中的每个位置
-        for (int y = 0; y < height; y++) {         // 行循环
-            for (int x = 0; x < width; x++) {      // 列循环
-                // 获取当前像素的颜色值（BGR格式）
-                cv::Vec3b pixel = colorFrame.at<cv::Vec3b>(y, x);
-
-                // 计算像素亮度（灰度值）
-                // 使用加权平均公式：亮度 = (0.299*R + 0.587*G + 0.114*B) / 255
-                // 除以255将亮度归一化到[0, 1]范围
-                double brightness = (ASCIIVideoConstants::RED_WEIGHT * pixel[2] +   // 红色通道
-                ASCIIVideoConstants::GREEN_WEIGHT * pixel[1] + // 绿色通道
-                ASCIIVideoConstants::BLUE_WEIGHT * pixel[0]) / 255.0; // 蓝色通道
-
-                // 根据亮度选择对应的ASCII字符
-                char asciiChar = getASCIIChar(brightness);
-
-                // 使用像素的原始颜色作为字符颜色
-                // OpenCV使用BGR格式：Scalar(blue, green, red)
-                cv::Scalar textColor(pixel[0], pixel[1], pixel[2]);
-
-                // 计算字符绘制位置
-                // x方向：字符索引 × 字符宽度
-                // y方向：(字符索引+1) × 字符高度 - 2（微调使字符垂直居中）
-                cv::Point textPos(x * ASCIIVideoConstants::ASCII_CHAR_WIDTH,
-                                  (y + 1) * ASCIIVideoConstants::ASCII_CHAR_HEIGHT - 2);
-
-                // 在输出图像上绘制ASCII字符
-                cv::putText(asciiFrame,                    // 目标图像
-                            std::string(1, asciiChar),     // 要绘制的文本（单个字符）
-                            textPos,                       // 绘制位置
-                            cv::FONT_HERSHEY_SIMPLEX,      // 字体类型
-                            ASCIIVideoConstants::ASCII_FONT_SIZE, // 字体大小
-                            textColor,                     // 文字颜色
-                            1,                             // 线条粗细
-                            cv::LINE_AA);                  // 抗锯齿
+    /*
+     * 更新自动色阶函数
+     * 每帧结束时从直方图中取暗部、亮部百分位作为黑位和白位，
+     * 按AUTOLEVELS_SMOOTHING与之前的值做指数平滑后折算进字符查找表，
+     * 新色阶从下一帧开始生效，因此不需要为统计直方图额外遍历画面
+     */
+    void updateAutoLevels() {
+        if (!options.autoLevels) {
+            return;
+        }
 
-                // 调试输出：只在第一帧的前6个像素显示亮度到字符的映射关系
-                // 帮助理解字符选择过程，实际运行时只执行一次
-                if (x < 3 && y < 2 && frameCount == 0) {
-                    std::cout << "像素(" << x << "," << y << "): 亮度=" << std::fixed
-                    << std::setprecision(3) << brightness << ", 字符='"
-                    << asciiChar << "'" << std::endl;
-                }
-            }
+        int total = 0;
+        for (int count : lumaHistogram) {
+            total += count;
+        }
+        if (total == 0) {
+            return;
         }
 
-        return asciiFrame;  // 返回生成的ASCII艺术帧
+        // 在累计分布中找到两端的百分位
+        int clip = static_cast<int>(total * ASCIIVideoConstants::AUTOLEVELS_CLIP_FRACTION);
+        int low = 0, high = 255, accumulated = 0;
+        while (low < 255 && accumulated + lumaHistogram[low] <= clip) {
+            accumulated += lumaHistogram[low++];
+        }
+        accumulated = 0;
+        while (high > low && accumulated + lumaHistogram[high] <= clip) {
+            accumulated += lumaHistogram[high--];
+        }
+
+        // 亮度范围过窄时以中点为中心扩展到最小范围
+        if (high - low < ASCIIVideoConstants::AUTOLEVELS_MIN_RANGE) {
+            int center = (low + high) / 2;
+            low = std::max(0, center - ASCIIVideoConstants::AUTOLEVELS_MIN_RANGE / 2);
+            high = std::min(255, low + ASCIIVideoConstants::AUTOLEVELS_MIN_RANGE);
+        }
+
+        // 第一帧直接采用，之后做指数平滑，避免色阶随画面闪烁
+        double alpha = frameCount == 0 ? 1.0 : ASCIIVideoConstants::AUTOLEVELS_SMOOTHING;
+        levelLow += alpha * (low - levelLow);
+        levelHigh += alpha * (high - levelHigh);
+
+        rebuildGlyphLut();
+        std::fill(lumaHistogram, lumaHistogram + 256, 0);
     }
 
     /*
-     * 获取ASCII字符函数
-     * 根据亮度值选择对应的ASCII字符
+     * 获取字形编号函数
+     * 根据亮度值选择对应的ASCII字符在字符集中的位置
      *
      * 参数：
      *   brightness: 归一化的亮度值，范围应为[0, 1]
      *
      * 返回值：
-     *   char: 对应亮度的ASCII字符
+     *   int: 对应亮度的字符在字符集中的位置（即字形图集中的编号）
      *
      * 映射原理：
      *   1. 确保亮度值在有效范围[0, 1]内
      *   2. 将亮度线性映射到字符集索引
-     *   3. 通过索引从字符集中选择字符
      */
-    char getASCIIChar(double brightness) {
+    int getGlyphIndex(double brightness) {
         // 步骤1：确保亮度值在有效范围内
         // 使用std::min和std::max将亮度限制在[0, 1]区间
         brightness = std::max(0.0, std::min(1.0, brightness));
 
         // 步骤2：计算字符索引
         // 将亮度线性映射到字符集索引范围[0, charset.length()-1]
-        int index = static_cast<int>(brightness * (currentCharset.length() - 1));
+        int index = static_cast<int>(brightness * (glyphCodepoints.size() - 1));
 
         // 步骤3：确保索引在有效范围内
         // 再次使用std::min和std::max防止索引越界
-        index = std::max(0, std::min(static_cast<int>(currentCharset.length() - 1), index));
+        return std::max(0, std::min(static_cast<int>(glyphCodepoints.size() - 1), index));
+    }
+};
+
+/*
+ * ConversionJob结构
+ * 并发任务模式中的一个转换任务：输入输出路径、独立的转换器和编解码对象
+ * 每个任务的步骤严格按顺序执行，同一时刻只在一个线程上运行，任务之间不共享状态
+ */
+struct ConversionJob {
+    std::string inputPath;
+    std::string outputPath;
+    EnhancedASCIIConverter converter;
+    cv::VideoCapture capture;
+    cv::VideoWriter writer;
+    cv::Mat frame;        // 当前读入的帧
+    cv::Mat asciiFrame;   // 当前渲染结果
+    bool succeeded = false;
+
+    InputPrefetcher prefetcher;  // 输入预读线程
+    size_t readaheadBytes;       // 预读窗口（字节）
+    int totalFrames = 0;         // 输入总帧数（用于估计解码位置）
+    int framesRead = 0;          // 已读入的帧数
+
+    ConversionJob(const std::string& input, const std::string& output, const ConversionOptions& options)
+        : inputPath(input), outputPath(output), converter(options),
+          readaheadBytes(static_cast<size_t>(options.readaheadMB) << 20) {}
+};
+
+/*
+ * 打开任务输入并准备输出的公共步骤（在I/O线程上执行）
+ * 返回值：失败时输出错误信息并返回false
+ */
+inline bool openJob(ConversionJob& job, int asciiWidth) {
+    if (!job.capture.open(job.inputPath)) {
+        std::cerr << "无法打开视频文件: " << job.inputPath << std::endl;
+        return false;
+    }
+    double fps = job.capture.get(cv::CAP_PROP_FPS);
+    int width = static_cast<int>(job.capture.get(cv::CAP_PROP_FRAME_WIDTH));
+    int height = static_cast<int>(job.capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    job.totalFrames = static_cast<int>(job.capture.get(cv::CAP_PROP_FRAME_COUNT));
+    job.prefetcher.start(job.inputPath, job.readaheadBytes);
+    cv::Size frameSize;
+    return job.converter.beginStream(asciiWidth, width, height, frameSize) &&
+           job.converter.openOutput(job.writer, job.outputPath, fps, frameSize);
+}
+
+// 读入任务的下一帧并推进预读位置（在I/O线程上执行）
+inline bool readJobFrame(ConversionJob& job) {
+    if (!job.capture.read(job.frame)) {
+        return false;
+    }
+    job.prefetcher.advance(++job.framesRead, job.totalFrames);
+    return true;
+}
+
+// 任务结束：释放编解码对象并输出结果；返回值表示输出是否全部写出成功
+inline bool finishJob(ConversionJob& job) {
+    job.prefetcher.stop();
+    job.capture.release();
+    if (!job.converter.closeOutput(job.writer)) {
+        return false;
+    }
+    std::cout << "任务完成: " << job.inputPath << " -> " << job.outputPath
+              << "，" << job.converter.getFrameCount() << " 帧" << std::endl;
+    return true;
+}
+
+#ifdef MIKU_HAS_COROUTINES
+/*
+ * JobScheduler类
+ * 协程事件循环：少量渲染线程从就绪队列取出协程恢复执行，
+ * 协程遇到阻塞操作（打开文件、读帧、写帧）时把操作交给I/O线程池并挂起，
+ * 操作完成后重新放回就绪队列；某个输入读得慢只占用一个I/O线程，其他任务继续交错执行
+ */
+class JobScheduler {
+private:
+    std::deque<std::coroutine_handle<>> ready;       // 就绪的协程
+    std::deque<std::function<void()>> ioQueue;       // 待执行的阻塞操作
+    std::mutex mutex;
+    std::condition_variable readyCondition;
+    std::condition_variable ioCondition;
+    int activeJobs = 0;                              // 尚未结束的任务数
+    bool stopping = false;
+
+public:
+    /*
+     * I/O等待对象
+     * co_await scheduler.io(操作) 把操作交给I/O线程，完成后协程回到渲染线程继续执行
+     */
+    struct IOAwaitable {
+        JobScheduler& scheduler;
+        std::function<void()> work;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            scheduler.submitIO([this, handle] {
+                work();
+                scheduler.schedule(handle);
+            });
+        }
+        void await_resume() const noexcept {}
+    };
+
+    IOAwaitable io(std::function<void()> work) {
+        return IOAwaitable{*this, std::move(work)};
+    }
+
+    // 登记一个新任务并放入就绪队列
+    void addJob(std::coroutine_handle<> handle) {
+        std::lock_guard<std::mutex> lock(mutex);
+        activeJobs++;
+        ready.push_back(handle);
+    }
+
+    // 任务协程结束时调用；最后一个任务结束后通知所有线程退出
+    void jobFinished() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--activeJobs == 0) {
+            stopping = true;
+            readyCondition.notify_all();
+            ioCondition.notify_all();
+        }
+    }
+
+    void schedule(std::coroutine_handle<> handle) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.push_back(handle);
+        readyCondition.notify_one();
+    }
+
+    void submitIO(std::function<void()> work) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ioQueue.push_back(std::move(work));
+        ioCondition.notify_one();
+    }
+
+    /*
+     * 运行事件循环，直到所有任务结束
+     * 参数：
+     *   renderThreads: 渲染线程数
+     *   ioThreads: I/O线程数
+     */
+    void run(int renderThreads, int ioThreads) {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < ioThreads; ++i) {
+            threads.emplace_back([this] {
+                while (auto work = next(ioQueue, ioCondition)) {
+                    (*work)();
+                }
+            });
+        }
+        for (int i = 0; i < renderThreads; ++i) {
+            threads.emplace_back([this] {
+                while (auto handle = next(ready, readyCondition)) {
+                    handle->resume();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
 
-        // 步骤4：返回对应的ASCII字符
-        return currentCharset[index];
+private:
+    // 从队列取出下一项；没有任务且事件循环已停止时返回空
+    template <typename T>
+    std::optional<T> next(std::deque<T>& queue, std::condition_variable& condition) {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            return std::nullopt;
+        }
+        T item = std::move(queue.front());
+        queue.pop_front();
+        return item;
     }
 };
 
+/*
+ * JobTask协程类型
+ * 创建后先挂起，由调度器放入就绪队列后开始执行；结束时自动销毁协程帧
+ */
+struct JobTask {
+    struct promise_type {
+        JobTask get_return_object() {
+            return JobTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+/*
+ * 转换任务协程
+ * 读帧、写帧在I/O线程上执行，缩放和渲染在渲染线程上执行
+ */
+JobTask runJob(JobScheduler& scheduler, ConversionJob& job, int asciiWidth) {
+    bool opened = false;
+    co_await scheduler.io([&] { opened = openJob(job, asciiWidth); });
+
+    if (opened) {
+        while (true) {
+            bool hasFrame = false;
+            co_await scheduler.io([&] { hasFrame = readJobFrame(job); });
+            if (!hasFrame) {
+                break;
+            }
+            job.asciiFrame = job.converter.convertFrame(job.frame);
+            co_await scheduler.io([&] { job.converter.writeOutputFrame(job.writer, job.asciiFrame); });
+        }
+        co_await scheduler.io([&] { job.succeeded = finishJob(job); });
+    }
+    scheduler.jobFinished();
+}
+#endif
+
+/*
+ * 并发任务转换函数
+ * 同时转换多个输入输出对：支持C++20协程时在事件循环上交错执行，
+ * 否则每个任务使用一个线程顺序执行各步骤
+ *
+ * 返回值：
+ *   bool: 所有任务都成功时返回true
+ */
+bool runConversionJobs(std::vector<std::unique_ptr<ConversionJob>>& jobs, int asciiWidth) {
+    const int jobCount = static_cast<int>(jobs.size());
+#ifdef MIKU_HAS_COROUTINES
+    int renderThreads = std::max(1, std::min(jobCount, static_cast<int>(std::thread::hardware_concurrency())));
+    int ioThreads = std::min(jobCount, ASCIIVideoConstants::MAX_JOB_IO_THREADS);
+    std::cout << "并发任务: " << jobCount << " 个（协程调度，渲染线程 " << renderThreads
+              << "，I/O线程 " << ioThreads << "）" << std::endl;
+
+    JobScheduler scheduler;
+    for (auto& job : jobs) {
+        scheduler.addJob(runJob(scheduler, *job, asciiWidth).handle);
+    }
+    scheduler.run(renderThreads, ioThreads);
+#else
+    std::cout << "并发任务: " << jobCount << " 个（每个任务一个线程）" << std::endl;
+    std::vector<std::thread> threads;
+    for (auto& job : jobs) {
+        threads.emplace_back([&job, asciiWidth] {
+            if (!openJob(*job, asciiWidth)) {
+                return;
+            }
+            while (readJobFrame(*job)) {
+                job->converter.writeOutputFrame(job->writer, job->converter.convertFrame(job->frame));
+            }
+            job->succeeded = finishJob(*job);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+#endif
+    return std::all_of(jobs.begin(), jobs.end(), [](const auto& job) { return job->succeeded; });
+}
+
+/*
+ * 解析网格规格函数
+ * 将形如"3x2"的字符串解析为列数和行数
+ *
+ * 返回值：
+ *   bool: 格式正确且数值为正返回true
+ */
+bool parseGridSpec(const std::string& spec, int& cols, int& rows) {
+    size_t pos = spec.find('x');
+    if (pos == std::string::npos) {
+        return false;
+    }
+    cols = std::atoi(spec.substr(0, pos).c_str());
+    rows = std::atoi(spec.substr(pos + 1).c_str());
+    return cols > 0 && rows > 0;
+}
+
+/*
+ * 解析矩形区域函数
+ * 将形如"x,y,w,h"的字符串解析为矩形（像素坐标）
+ *
+ * 返回值：
+ *   bool: 格式正确且宽高为正返回true
+ */
+bool parseRectSpec(const std::string& spec, cv::Rect& rect) {
+    int values[4];
+    size_t start = 0;
+    for (int i = 0; i < 4; ++i) {
+        size_t end = spec.find(',', start);
+        if ((end == std::string::npos) != (i == 3)) {
+            return false;
+        }
+        values[i] = std::atoi(spec.substr(start, end - start).c_str());
+        start = end + 1;
+    }
+    rect = cv::Rect(values[0], values[1], values[2], values[3]);
+    return rect.x >= 0 && rect.y >= 0 && rect.width > 0 && rect.height > 0;
+}
+
 /*
  * 主函数
  * 程序的入口点，处理命令行参数并启动转换过程
@@ -381,24 +4972,247 @@ private:
  *   5. 输出结果
  */
 int main(int argc, char* argv[]) {
-    // 步骤1：检查命令行参数数量
-    // 至少需要输入文件和输出文件两个参数
-    if (argc < 3) {
-        std::cout << "用法: " << argv[0] << " <input-video> <output-video> [ASCII宽度]" << std::endl;
+    // 步骤1：解析命令行参数
+    // 以"--"开头的参数为可选项，其余参数依次为：输入文件、输出文件、ASCII宽度、质量
+    std::vector<std::string> positional;
+    std::vector<std::string> mosaicInputs;  // 拼接模式的额外输入
+    int mosaicCols = 0;
+    int mosaicRows = 0;
+    ConversionOptions options;  // 可选功能开关
+    std::string dumpHeaderPath;  // 生成内嵌字形头文件的路径
+    int benchFrames = 0;  // 编码器基准测试的帧数（0表示不测试）
+    std::string decodeGridPath;  // 要解码的字符网格文件
+    std::vector<std::pair<std::string, std::string>> jobPaths;  // 并发任务模式的输入输出对
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--mosaic" && hasValue) {
+            if (!parseGridSpec(argv[++i], mosaicCols, mosaicRows)) {
+                std::cerr << "错误: 拼接布局格式应为 列数x行数，例如 2x2" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--input" && hasValue) {
+            mosaicInputs.push_back(argv[++i]);
+        } else if (arg == "--autocrop") {
+            options.autoCrop = true;
+        } else if (arg == "--crop" && hasValue) {
+            if (!parseRectSpec(argv[++i], options.crop)) {
+                std::cerr << "错误: 裁剪区域格式应为 x,y,宽,高" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--sat") {
+            options.summedAreaAnalysis = true;
+        } else if (arg == "--supersample" && hasValue) {
+            options.supersample = std::atoi(argv[++i]);
+            if (options.supersample < 1 || options.supersample > ASCIIVideoConstants::MAX_SUPERSAMPLE) {
+                std::cerr << "错误: 超采样数应在1-" << ASCIIVideoConstants::MAX_SUPERSAMPLE << "之间" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--linear") {
+            options.linearLight = true;
+        } else if (arg == "--autolevels") {
+            options.autoLevels = true;
+        } else if (arg == "--hysteresis" && hasValue) {
+            options.hysteresisDeltaE = std::atof(argv[++i]);
+            if (options.hysteresisDeltaE <= 0.0 || options.hysteresisDeltaE > 50.0) {
+                std::cerr << "错误: 感知滤波阈值应在0-50之间（ΔE）" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--mono") {
+            options.mono = true;
+        } else if (arg == "--charset" && hasValue) {
+            options.charset = argv[++i];
+            std::vector<char32_t> codepoints;
+            if (!decodeUTF8(options.charset, codepoints) || codepoints.size() < 2 ||
+                codepoints.size() > static_cast<size_t>(ASCIIVideoConstants::MAX_CHARSET_GLYPHS)) {
+                std::cerr << "错误: 字符集应为2到" << ASCIIVideoConstants::MAX_CHARSET_GLYPHS
+                          << "个字符的UTF-8字符串" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--batch" && hasValue) {
+            options.batchFrames = std::atoi(argv[++i]);
+            if (options.batchFrames < 1 || options.batchFrames > ASCIIVideoConstants::MAX_BATCH_FRAMES) {
+                std::cerr << "错误: 批大小应在1-" << ASCIIVideoConstants::MAX_BATCH_FRAMES << "之间" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--interlace" && hasValue) {
+            options.interlace = std::atoi(argv[++i]);
+            if (options.interlace < 1 || options.interlace > ASCIIVideoConstants::MAX_INTERLACE) {
+                std::cerr << "错误: 隔行更新间隔应在1-" << ASCIIVideoConstants::MAX_INTERLACE << "之间" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--readahead" && hasValue) {
+            options.readaheadMB = std::atoi(argv[++i]);
+            if (options.readaheadMB < 0 || options.readaheadMB > ASCIIVideoConstants::MAX_READAHEAD_MB) {
+                std::cerr << "错误: 预读窗口应在0-" << ASCIIVideoConstants::MAX_READAHEAD_MB << " MB之间" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--segment" && hasValue) {
+            options.segmentSeconds = std::atof(argv[++i]);
+            if (options.segmentSeconds < ASCIIVideoConstants::MIN_SEGMENT_SECONDS ||
+                options.segmentSeconds > ASCIIVideoConstants::MAX_SEGMENT_SECONDS) {
+                std::cerr << "错误: 分段时长应在" << ASCIIVideoConstants::MIN_SEGMENT_SECONDS << "-"
+                          << ASCIIVideoConstants::MAX_SEGMENT_SECONDS << "秒之间" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--grid-out" && hasValue) {
+            options.gridOutputPath = argv[++i];
+        } else if (arg == "--coverage-comp") {
+            options.coverageCompensation = true;
+        } else if (arg == "--font" && hasValue) {
+            options.fontPath = argv[++i];
+        } else if (arg == "--font-size" && hasValue) {
+            options.fontPixelSize = std::atoi(argv[++i]);
+            if (options.fontPixelSize < 4 || options.fontPixelSize > 4 * ASCIIVideoConstants::ASCII_CHAR_HEIGHT) {
+                std::cerr << "错误: 字体像素大小应在4到" << 4 * ASCIIVideoConstants::ASCII_CHAR_HEIGHT << "之间" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--font-bold") {
+            options.fontBold = true;
+        } else if (arg == "--bgfill" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode != "glyph" && mode != "none") {
+                std::cerr << "错误: 背景填充模式应为 glyph 或 none" << std::endl;
+                return 1;
+            }
+            options.backgroundFill = true;
+            options.backgroundGlyphs = mode == "glyph";
+        } else if (arg == "--job" && i + 2 < argc) {
+            jobPaths.emplace_back(argv[i + 1], argv[i + 2]);
+            i += 2;
+        } else if (arg == "--lossless") {
+            options.lossless = true;
+        } else if (arg == "--bench-codecs" && hasValue) {
+            benchFrames = std::atoi(argv[++i]);
+            if (benchFrames < 1 || benchFrames > ASCIIVideoConstants::MAX_BENCH_FRAMES) {
+                std::cerr << "错误: 基准测试帧数应在1-" << ASCIIVideoConstants::MAX_BENCH_FRAMES << "之间" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--decode-grid" && hasValue) {
+            decodeGridPath = argv[++i];
+        } else if (arg == "--dump-glyph-header" && hasValue) {
+            dumpHeaderPath = argv[++i];
+        } else if (arg == "--roi" && hasValue) {
+            std::string spec = argv[++i];
+            options.roiEnabled = true;
+            options.roiCenter = spec == "center";
+            if (!options.roiCenter && !parseRectSpec(spec, options.roi)) {
+                std::cerr << "错误: 兴趣区域格式应为 x,y,宽,高 或 center" << std::endl;
+                return 1;
+            }
+        } else if (arg.compare(0, 2, "--") == 0) {
+            std::cerr << "错误: 未知选项或缺少参数值: " << arg << std::endl;
+            return 1;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    // 生成内嵌字形头文件：用putText绘制默认字符集图集并写出，不转换视频
+    if (!dumpHeaderPath.empty()) {
+        GlyphAtlas atlas;
+        std::vector<char32_t> codepoints;
+        decodeUTF8(ASCIIVideoConstants::ASCII_CHARS, codepoints);
+        if (!atlas.build(codepoints, 1) || !atlas.writeHeader(dumpHeaderPath, ASCIIVideoConstants::ASCII_CHARS)) {
+            return 1;
+        }
+        std::cout << "已生成内嵌字形头文件: " << dumpHeaderPath << std::endl;
+        return 0;
+    }
+
+    // 字符网格解码：位置参数为输出路径，字符集、灰度和渲染模式取自网格文件头
+    if (!decodeGridPath.empty()) {
+        std::ifstream gridFile(decodeGridPath, std::ios::binary);
+        GridFileHeader header;
+        std::vector<char32_t> codepoints;
+        if (!gridFile || !readGridHeader(gridFile, header)) {
+            std::cerr << "无法读取字符网格文件: " << decodeGridPath << std::endl;
+            return 1;
+        }
+        if (!decodeUTF8(header.charset, codepoints) || codepoints.size() < 2 ||
+            codepoints.size() > static_cast<size_t>(ASCIIVideoConstants::MAX_CHARSET_GLYPHS)) {
+            std::cerr << "错误: 字符网格文件中的字符集无效" << std::endl;
+            return 1;
+        }
+        if (positional.size() != 1) {
+            std::cerr << "用法: " << argv[0] << " --decode-grid <网格文件> <输出>" << std::endl;
+            return 1;
+        }
+        options.charset = header.charset;
+        options.mono = header.mono != 0;
+        options.backgroundFill = (header.modes & GridFormat::MODE_BACKGROUND_FILL) != 0;
+        options.backgroundGlyphs = (header.modes & GridFormat::MODE_BACKGROUND_GLYPHS) != 0;
+        options.coverageCompensation = (header.modes & GridFormat::MODE_COVERAGE_COMPENSATION) != 0;
+        EnhancedASCIIConverter decoder(options);
+        return decoder.decodeGridFile(decodeGridPath, positional[0]) ? 0 : 1;
+    }
+
+    // 编码器基准测试：位置参数为输入视频和可选的ASCII宽度，不输出视频
+    if (benchFrames > 0) {
+        int benchWidth = positional.size() >= 2 ? std::atoi(positional[1].c_str()) : ASCIIVideoConstants::DEFAULT_ASCII_WIDTH;
+        if (positional.empty() || positional.size() > 2 ||
+            benchWidth < ASCIIVideoConstants::MIN_ASCII_WIDTH || benchWidth > ASCIIVideoConstants::MAX_ASCII_WIDTH) {
+            std::cerr << "用法: " << argv[0] << " --bench-codecs 帧数 <input-video> [ASCII宽度]" << std::endl;
+            return 1;
+        }
+        EnhancedASCIIConverter benchConverter(options);
+        return benchConverter.benchmarkCodecs(positional[0], benchWidth, benchFrames) ? 0 : 1;
+    }
+
+    // 至少需要输入文件和输出文件两个参数（并发任务模式的输入输出由 --job 给出）
+    const bool jobMode = !jobPaths.empty();
+    if (positional.size() < (jobMode ? 0u : 2u) || (jobMode && positional.size() > 1)) {
+        std::cout << "用法: " << argv[0] << " <input-video> <output-video> [ASCII宽度] [选项]" << std::endl;
+        std::cout << "      " << argv[0] << " --job <输入> <输出> [--job <输入> <输出> ...] [ASCII宽度] [选项]" << std::endl;
         std::cout << "示例: " << argv[0] << " miku.mp4 ascii.mp4" << std::endl;
         std::cout << "示例: " << argv[0] << " miku.mp4 ascii.mp4 120" << std::endl;
+        std::cout << "示例: " << argv[0] << " miku.mp4 frames/%06d.png 120  （输出路径含帧编号时写成图像序列）" << std::endl;
         std::cout << "建议ASCII宽度: 60-150 (数值越大越清晰但文件越大)" << std::endl;
+        std::cout << "选项:" << std::endl;
+        std::cout << "  --mosaic CxR     拼接模式，C列R行，第一个输入为<input-video>" << std::endl;
+        std::cout << "  --input <视频>   拼接模式的额外输入，可重复指定" << std::endl;
+        std::cout << "  --job IN OUT     并发任务：同时转换多个输入输出对，可重复指定" << std::endl;
+        std::cout << "  --autocrop       自动检测并裁剪黑边（启动时和场景切换时检测）" << std::endl;
+        std::cout << "  --crop x,y,w,h   手动裁剪区域（原始视频像素坐标）" << std::endl;
+        std::cout << "  --roi x,y,w,h    兴趣区域使用正常密度网格，外围使用放大的字符格；也可写 center" << std::endl;
+        std::cout << "  --sat            使用积分图分析路径（任意比例网格，每格O(1)求平均）" << std::endl;
+        std::cout << "  --supersample N  每个字符格取NxN个采样点求平均（1-4，只用于--sat）" << std::endl;
+        std::cout << "  --linear         在线性光空间缩放（伽马正确，高反差细节不变暗）" << std::endl;
+        std::cout << "  --autolevels     自动色阶：按亮度直方图拉伸，暗画面也能用满字符集" << std::endl;
+        std::cout << "  --hysteresis dE  感知时间滤波：Lab色差小于dE的字符格保持不变，无变化的帧直接复用" << std::endl;
+        std::cout << "  --mono           灰度模式：只处理亮度，单通道渲染并输出灰度视频" << std::endl;
+        std::cout << "  --charset CHARS  自定义字符集（UTF-8，从暗到亮），支持方块元素、阴影、制表符；" << std::endl;
+        std::cout << "                   其他非ASCII字符需要 --font，含全角字符时每个字符占两格" << std::endl;
+        std::cout << "  --batch K        批量分析：一次读入K帧并行缩放，小网格时提高吞吐量" << std::endl;
+        std::cout << "  --interlace N    隔行更新：每帧只分析、渲染1/N的字符行（轮换），用于低延迟预览" << std::endl;
+        std::cout << "  --readahead MB   输入预读窗口（默认" << ASCIIVideoConstants::READAHEAD_DEFAULT_MB
+                  << "，0关闭）：本地文件提前读入页缓存" << std::endl;
+        std::cout << "  输出为 .gif / .webp 时写出循环播放的动画图像（WebP需要编译时启用）" << std::endl;
+        std::cout << "  --segment SEC    分段输出：输出路径为.m3u8播放列表，每SEC秒一个.ts分段，边转换边可播放" << std::endl;
+        std::cout << "  --grid-out PATH  同时输出字符网格文件（每帧的字形编号和颜色，.mgrid格式）" << std::endl;
+        std::cout << "  --coverage-comp  覆盖率补偿：按字符笔画覆盖率提亮字符颜色，细笔画字符不再偏暗" << std::endl;
+        std::cout << "  --font PATH      用指定的TTF/OTF/点阵字体文件渲染字符（需要FreeType支持，不附带字体），图集缓存在 ~/.cache/miku" << std::endl;
+        std::cout << "  --font-size PX   字体像素大小（默认自动选择能放进字符格的最大字号）" << std::endl;
+        std::cout << "  --font-bold      加粗字体轮廓" << std::endl;
+        std::cout << "  --bgfill MODE    背景填充模式：字符格填平均颜色，MODE为glyph（叠加对比色字符）或none" << std::endl;
+        std::cout << "  --lossless       无损输出（FFV1/PNG/未压缩RGBA，输出为 .mkv 或 .avi），供剪辑和再编码使用" << std::endl;
+        std::cout << "  --bench-codecs N 渲染输入的前N帧，比较各编码器的写出速度和文件大小后退出" << std::endl;
+        std::cout << "  --decode-grid F  把字符网格文件渲染成视频：" << argv[0] << " --decode-grid in.mgrid out.mp4" << std::endl;
+        std::cout << "  --dump-glyph-header PATH  生成内嵌的默认字形图集头文件（miku_glyphs.h）后退出" << std::endl;
         return 1;  // 返回错误码1：参数不足
     }
 
-    // 步骤2：解析命令行参数
-    std::string inputPath = argv[1];   // 第一个参数：输入视频文件路径
-    std::string outputPath = argv[2];  // 第二个参数：输出视频文件路径
+    // 步骤2：读取位置参数
+    std::string inputPath = jobMode ? "" : positional[0];   // 第一个参数：输入视频文件路径
+    std::string outputPath = jobMode ? "" : positional[1];  // 第二个参数：输出视频文件路径
     int asciiWidth = ASCIIVideoConstants::DEFAULT_ASCII_WIDTH;  // 第三个参数：ASCII宽度（可选）
 
-    // 如果提供了第三个参数（ASCII宽度），则使用用户指定的值
-    if (argc >= 4) {
-        asciiWidth = std::atoi(argv[3]);  // 将字符串转换为整数
+    // 如果提供了第三个参数（ASCII宽度），则使用用户指定的值；并发任务模式中宽度是唯一的位置参数
+    const size_t widthIndex = jobMode ? 0 : 2;
+    if (positional.size() > widthIndex) {
+        asciiWidth = std::atoi(positional[widthIndex].c_str());  // 将字符串转换为整数
     }
 
     // 步骤3：验证ASCII宽度参数是否在有效范围内
@@ -406,47 +5220,132 @@ int main(int argc, char* argv[]) {
         asciiWidth > ASCIIVideoConstants::MAX_ASCII_WIDTH) {
         std::cerr << "错误: ASCII宽度应在" << ASCIIVideoConstants::MIN_ASCII_WIDTH
         << "-" << ASCIIVideoConstants::MAX_ASCII_WIDTH << "之间" << std::endl;
-    return 1;  // 返回错误码1：参数无效
+        return 1;  // 返回错误码1：参数无效
+    }
+
+    // 拼接模式：第一个输入加上所有--input输入，数量不能超过布局格数
+    std::vector<std::string> allInputs{inputPath};
+    allInputs.insert(allInputs.end(), mosaicInputs.begin(), mosaicInputs.end());
+    if (mosaicCols > 0) {
+        int cells = mosaicCols * mosaicRows;
+        if (static_cast<int>(allInputs.size()) > cells ||
+            static_cast<int>(allInputs.size()) > ASCIIVideoConstants::MAX_MOSAIC_INPUTS ||
+            asciiWidth / mosaicCols < ASCIIVideoConstants::MIN_ASCII_WIDTH / 4) {
+            std::cerr << "错误: 输入数量超过拼接布局格数或上限，或子区域过窄" << std::endl;
+            return 1;
+        }
+        // 各输入在解码线程内直接用INTER_AREA缩放到子网格，不经过积分图采样
+        if (options.autoCrop || options.crop.area() > 0 || options.roiEnabled || options.summedAreaAnalysis ||
+            options.supersample > 1) {
+            std::cerr << "错误: 拼接模式不支持裁剪、兴趣区域、--sat 和 --supersample 选项" << std::endl;
+            return 1;
         }
+    } else if (!mosaicInputs.empty()) {
+        std::cerr << "错误: --input 需要与 --mosaic 一起使用" << std::endl;
+        return 1;
+    }
 
-        // 步骤4：创建ASCII转换器实例
-        EnhancedASCIIConverter converter;
+    // 并发任务只支持逐帧缩放的均匀网格路径，每个任务的转换器各自独立
+    if (jobMode && (mosaicCols > 0 || options.autoCrop || options.crop.area() > 0 || options.roiEnabled ||
+                    options.summedAreaAnalysis || options.interlace > 1 || options.batchFrames > 1 ||
+                    !options.gridOutputPath.empty())) {
+        std::cerr << "错误: --job 不支持 --mosaic、裁剪、--roi、--sat、--interlace、--batch 和 --grid-out" << std::endl;
+        return 1;
+    }
 
-        // 步骤5：显示程序标题和分隔符
-        std::cout << "========================================" << std::endl;
-        std::cout << "原彩ASCII视频转换器" << std::endl;
-        std::cout << "========================================" << std::endl;
+    // 分段输出使用MPEG-TS容器，不能放入无损编码器
+    if (options.lossless && options.segmentSeconds > 0.0) {
+        std::cerr << "错误: --lossless 不支持 --segment" << std::endl;
+        return 1;
+    }
 
-        // 步骤6：执行视频转换
-        if (converter.convertToColorASCII(inputPath, outputPath, asciiWidth, 1.0)) {
-            // 转换成功：显示成功信息和输出文件路径
-            std::cout << "========================================" << std::endl;
-            std::cout << "成功创建彩色ASCII视频!" << std::endl;
-            std::cout << "输出文件: " << outputPath << std::endl;
-            std::cout << "========================================" << std::endl;
-            return 0;  // 返回0：程序执行成功
-        } else {
-            // 转换失败：显示错误信息
-            std::cerr << "========================================" << std::endl;
-            std::cerr << "转换失败!" << std::endl;
-            std::cerr << "========================================" << std::endl;
-            return 1;  // 返回1：转换失败
+    // 灰度模式和背景填充模式只走均匀网格的渲染路径
+    if ((options.mono || options.backgroundFill) && options.roiEnabled) {
+        std::cerr << "错误: --mono 和 --bgfill 不支持 --roi" << std::endl;
+        return 1;
+    }
+    // 批量分析只替换单输入的缩放路径；自动裁剪检测到的新区域从下一批开始生效
+    if (options.batchFrames > 1 &&
+        (mosaicCols > 0 || options.roiEnabled || options.summedAreaAnalysis || options.interlace > 1)) {
+        std::cerr << "错误: --batch 不支持 --mosaic、--roi、--sat 和 --interlace" << std::endl;
+        return 1;
+    }
+
+    // 可变密度模式的字符格大小不一，不经过字符网格
+    if (!options.gridOutputPath.empty() && options.roiEnabled) {
+        std::cerr << "错误: --grid-out 不支持 --roi" << std::endl;
+        return 1;
+    }
+
+    // 隔行更新只作用于单输入的均匀网格缩放路径，整帧复用由它自己负责
+    if (options.interlace > 1 &&
+        (mosaicCols > 0 || options.roiEnabled || options.summedAreaAnalysis || options.hysteresisDeltaE > 0.0)) {
+        std::cerr << "错误: --interlace 不支持 --mosaic、--roi、--sat 和 --hysteresis" << std::endl;
+        return 1;
+    }
+
+    if ((options.fontPixelSize > 0 || options.fontBold) && options.fontPath.empty()) {
+        std::cerr << "错误: --font-size 和 --font-bold 需要同时指定 --font" << std::endl;
+        return 1;
+    }
+    if (options.mono && options.backgroundFill) {
+        std::cerr << "错误: --mono 与 --bgfill 不能同时使用" << std::endl;
+        return 1;
+    }
+
+    // 步骤4：创建ASCII转换器实例
+    EnhancedASCIIConverter converter(options);
+
+    // 步骤5：显示程序标题和分隔符
+    std::cout << "========================================" << std::endl;
+    std::cout << "原彩ASCII视频转换器" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    // 步骤6：执行视频转换
+    bool success;
+    if (jobMode) {
+        std::vector<std::unique_ptr<ConversionJob>> jobs;
+        for (const auto& paths : jobPaths) {
+            jobs.push_back(std::make_unique<ConversionJob>(paths.first, paths.second, options));
         }
+        success = runConversionJobs(jobs, asciiWidth);
+        outputPath = jobPaths.size() == 1 ? jobPaths[0].second : std::to_string(jobPaths.size()) + " 个输出文件";
+    } else {
+        success = mosaicCols > 0
+            ? converter.convertMosaicASCII(allInputs, outputPath, asciiWidth, mosaicCols, mosaicRows)
+            : converter.convertToColorASCII(inputPath, outputPath, asciiWidth, 1.0);
+    }
+
+    if (success) {
+        // 转换成功：显示成功信息和输出文件路径
+        std::cout << "========================================" << std::endl;
+        std::cout << "成功创建彩色ASCII视频!" << std::endl;
+        std::cout << "输出文件: " << outputPath << std::endl;
+        std::cout << "========================================" << std::endl;
+        return 0;  // 返回0：程序执行成功
+    } else {
+        // 转换失败：显示错误信息
+        std::cerr << "========================================" << std::endl;
+        std::cerr << "转换失败!" << std::endl;
+        std::cerr << "========================================" << std::endl;
+        return 1;  // 返回1：转换失败
+    }
 }
 
 /*
  * 编译和运行说明：
  *
  * 1. 编译命令：
- *    g++ -O3 -march=native -std=c++17 -o miku miku.cpp \
- *        `pkg-config --cflags --libs opencv4` -lpthread
+ *    g++ -O3 -march=native -std=c++20 -o miku miku.cpp \
+ *        `pkg-config --cflags --libs opencv4` -lz -lpthread
  *
  *    参数解释：
  *    -O3: 最高级别优化，提高程序运行速度
  *    -march=native: 为当前CPU架构优化，充分利用CPU特性
- *    -std=c++17: 使用C++17标准，支持现代C++特性
+ *    -std=c++20: 使用C++20标准，启用 --job 的协程调度；也可用 -std=c++17 编译，此时 --job 每任务一个线程
  *    -o ascii_video: 指定输出可执行文件名
  *    `pkg-config --cflags --libs opencv4`: 自动获取OpenCV编译选项和链接库
+ *    -lz: 链接zlib，字符网格文件（--grid-out）的帧记录和字形图集用deflate压缩
  *    -lpthread: 链接POSIX线程库，提高多线程性能
  *
  * 2. 运行示例：
@@ -457,6 +5356,132 @@ int main(int argc, char* argv[]) {
  *    第二个参数：输出视频文件路径（建议使用.mp4扩展名）
  *    第三个参数：ASCII宽度（可选，默认80，建议值60-150）
  *
+ *    拼接模式（多个视频合成到同一个ASCII画面）：
+ *    ./miku a.mp4 wall.mp4 160 --mosaic 2x2 --input b.mp4 --input c.mp4 --input d.mp4
+ *    每个输入由独立线程解码，按时间戳与第一个输入的帧率同步
+ *
+ *    自动裁剪黑边（--autocrop）：
+ *    ./miku movie.mp4 ascii.mp4 120 --autocrop
+ *    启动时均匀采样若干帧检测黑边，场景切换后重新检测，检测结果会输出到控制台；
+ *    网格尺寸由首次检测确定，之后的内容区域扩展到相同宽高比（保留部分黑边），画面不会变形
+ *
+ *    手动裁剪与兴趣区域：
+ *    ./miku in.mp4 out.mp4 120 --crop 0,140,1920,800 --roi 760,300,400,400
+ *    兴趣区域（例如人脸框）内保持正常字符密度，外围每2x2个字符格合并为一个大字符
+ *    --roi center 使用画面中央区域
+ *
+ *    积分图分析（--sat）：
+ *    每帧建一次求和面积表，按像素范围直接求每个字符格的平均颜色，
+ *    网格与画面不成整数比例时也不会产生插值偏差
+ *
+ *    超采样（--supersample 2，需配合--sat）：
+ *    积分图路径输出2x2倍的采样网格，字符生成循环中直接求每格平均，减小格子边界取整带来的误差；
+ *    INTER_AREA缩放路径已按面积求平均，不再超采样
+ *
+ *    伽马正确缩放（--linear）：
+ *    像素经256项查找表转为12位线性光后再求平均，结果经反向查找表转回sRGB，
+ *    可与--sat、--supersample、--roi组合使用
+ *
+ *    自动色阶（--autolevels）：
+ *    字符生成时顺便统计字符格亮度直方图，取1%和99%百分位作为黑位、白位，
+ *    平滑后折算进亮度到字符的查找表，从下一帧起生效
+ *
+ *    感知时间滤波（--hysteresis 3）：
+ *    字符格颜色经Lab查找表（三线性插值）转换后比较ΔE，变化不可感知的字符格保持不变，
+ *    整帧无变化时复用上一帧输出；兴趣区域模式不使用此滤波
+ *
+ *    灰度模式（--mono）：
+ *    只计算亮度，单通道字形图块绘制到8位灰度帧并按灰度编码，
+ *    输出帧和编码器输入的数据量都只有彩色模式的三分之一
+ *
+ *    字符网格输出（--grid-out 文件.mgrid）：
+ *    分析阶段的结果是结构数组形式的字符网格（miku_grid.h：字形编号、B、G、R、标志平面，按缓存行对齐），
+ *    渲染器只读取网格；同时把每帧网格写入文件，格式见 miku_grid.h。
+ *    网格文件是面向字符画的编码：首帧和每250帧一个原始帧，其余帧只记录变化的字符格
+ *    （字形编号 + 与上一帧的颜色差值），每条帧记录再经deflate压缩；
+ *    miku.mp4 的240帧、120x56网格实测约2.8MB，未压缩的格式为4.5MB，
+ *    同样的帧按mp4v编码为9.2MB（720x672像素）；文件头记录背景填充、覆盖率补偿等渲染模式，
+ *    解码和播放按文件头的模式绘制，不需要再指定这些选项；文件头还保存了转换时的字形图集，
+ *    自定义字符集和 --font 字体的文件也能解码和播放；
+ *    解码用字形图集直接贴图：./miku --decode-grid ascii.mgrid ascii.mp4；
+ *    也可以不经视频编码直接播放：./miku_player ascii.mgrid（终端播放，见 miku_player.cpp）
+ *
+ *    输入预读（--readahead MB，默认64，0关闭）：
+ *    本地输入文件由预读线程按解码进度提前readahead到页缓存，窗口之外不预读；
+ *    机械硬盘或繁忙的存储上解码不再等待磁盘，网络流和管道不受影响
+ *    ./miku big.mkv ascii.mp4 120 --readahead 256
+ *
+ *    分段输出（--segment 秒数，输出路径为 .m3u8）：
+ *    视频切成 名称_00000.ts、名称_00001.ts ... 分段，每完成一段就更新HLS播放列表，
+ *    转换开始几秒后即可用 mpv/ffplay 打开播放列表观看；各分段由独立线程编码，
+ *    渲染线程写满一段后立即开始下一段，最多 MAX_SEGMENT_ENCODERS 段并行编码；
+ *    分段使用H.264编码（需要OpenCV的FFmpeg后端带H.264编码器），每段时间戳从0开始，
+ *    播放列表在分段之间写入 #EXT-X-DISCONTINUITY
+ *    ./miku input.mp4 live/ascii.m3u8 120 --segment 2
+ *
+ *    无损输出（--lossless，输出为 .mkv 或 .avi）：
+ *    按FFV1、PNG、未压缩RGBA的顺序选择编码器，下游剪辑软件和再编码没有代际损失；
+ *    这几种编码器的彩色和灰度输出都经过解码逐像素比对
+ *    ./miku input.mp4 master.mkv 120 --lossless
+ *
+ *    编码器基准测试（--bench-codecs 帧数）：
+ *    渲染输入的前N帧到内存，再用每个有损和无损编码器各写一遍，报告写出fps、文件大小和压缩比，
+ *    并把写出的文件解码回来与渲染结果比对，只有逐像素一致的才标记为无损
+ *    ./miku --bench-codecs 300 input.mp4 120
+ *
+ *    动画GIF / WebP（输出路径以 .gif / .webp 结尾）：
+ *    GIF使用固定全局调色板（彩色6x7x6 RGB立方体，灰度255级），每像素查一次32K项查找表
+ *    （按ΔE取最近的调色板颜色）完成量化；
+ *    每帧只编码与上一帧不同的矩形，矩形内未变化的像素写成透明色，重复帧合并为上一帧的延时；
+ *    帧率超过50fps时按整数间隔抽帧。WebP使用libwebp的动画编码器按无损模式编码：
+ *    g++ ... -DMIKU_WITH_WEBP miku.cpp `pkg-config --cflags --libs opencv4 libwebpmux` -lz -lpthread
+ *    ./miku input.mp4 chat.gif 60
+ *
+ *    图像序列输出（输出路径含帧编号占位符，如 frames/%06d.png）：
+ *    每帧在渲染线程编码到缓冲池中的一块缓冲区，由专用写出线程批量写盘，渲染不等待磁盘；
+ *    字符网格文件也经同一写出线程追加写入。编译时定义MIKU_WITH_URING并链接liburing后，
+ *    写出线程用io_uring一次提交整批写操作，缓冲池注册为固定缓冲区；否则逐个pwrite
+ *    g++ ... -DMIKU_WITH_URING miku.cpp `pkg-config --cflags --libs opencv4 liburing` -lz -lpthread
+ *
+ *    并发任务（--job 输入 输出，可重复）：
+ *    同时转换多个文件；用 -std=c++20 编译时各任务以协程形式运行在事件循环上，
+ *    打开文件、读帧、写帧交给I/O线程，缩放和渲染在少量渲染线程上交错执行，
+ *    某个输入（如网络文件系统上的文件）读得慢不会拖住其他任务；C++17编译时每个任务使用一个线程
+ *    ./miku --job a.mp4 a_ascii.mp4 --job b.mp4 b_ascii.mp4 120
+ *
+ *    批量分析（--batch K）：
+ *    一次读入K帧，各帧缩放在OpenCV线程池中并行执行并写入一块连续内存；未启用--autolevels和
+ *    --hysteresis时字形查找也在同一并行任务中完成，之后按顺序逐帧拷入网格并渲染；
+ *    网格很小时每帧工作量不足以填满线程池，按批处理可以摊薄每帧的固定开销
+ *
+ *    隔行更新（--interlace N）：
+ *    每帧只缩放、渲染行号模N等于帧号模N的字符行，其余行保留上一次的内容，
+ *    每帧工作量约为完整帧的1/N，适合弱硬件上的实时预览
+ *
+ *    覆盖率补偿（--coverage-comp）：
+ *    每个字符的颜色乘以该字形覆盖率倒数（相对最密字形，上限4倍），
+ *    增益表在建立图集时计算，渲染时每格只多一次查表和乘法；
+ *    彩色、灰度和兴趣区域模式使用同一增益表，笔画粗细一致。背景填充模式不补偿：
+ *    字符格亮度来自填充色，字符只是叠加的对比色
+ *
+ *    内嵌字形图集（miku_glyphs.h）：
+ *    默认字符集的字形图块在编译时内嵌，启动时不需要绘制；修改字体参数或升级OpenCV后可重新生成：
+ *    ./miku --dump-glyph-header miku_glyphs.h，然后重新编译；删除该文件时自动回退到运行时绘制
+ *
+ *    自定义字符集（--charset "字符"，UTF-8，从暗到亮）：
+ *    例如 --charset " ░▒▓█" 或 --charset " ▖▚▜█"；方块元素、阴影、制表符由程序绘制，
+ *    其他非ASCII字符（如中日韩文字）需要同时指定 --font；含全角字符时每个字符占两个字符格
+ *
+ *    字体渲染（--font 字体.ttf [--font-size 像素] [--font-bold]）：
+ *    用FreeType把字符集光栅化到字形图集，需要编译时启用：
+ *    g++ -O3 -march=native -std=c++17 -DMIKU_WITH_FREETYPE -o miku miku.cpp \
+ *        `pkg-config --cflags --libs opencv4 freetype2` -lz -lpthread
+ *    图集按字体、字号和字符集缓存在 ~/.cache/miku，之后启动直接读取
+ *
+ *    背景填充模式（--bgfill glyph 或 --bgfill none）：
+ *    每个字符格填满平均颜色（整行内存拷贝），再叠加对比色字符或不画字符，
+ *    画面由平坦色块组成，编码后文件更小
+ *
  * 4. 性能提示：
  *    - ASCII宽度越大，输出视频越清晰，但处理时间和文件大小也越大
  *    - 处理长视频时可能需要较长时间，请耐心等待
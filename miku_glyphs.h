@@ -0,0 +1,941 @@
+// 内嵌的默认字形图集，由 ./miku --dump-glyph-header 生成，请勿手工修改
+// FONT_HERSHEY_SIMPLEX，字号 0.3，抗锯齿，OpenCV 5.0.0
+#ifndef MIKU_GLYPHS_H
+#define MIKU_GLYPHS_H
+
+namespace EmbeddedGlyphs {
+    constexpr int TILE_WIDTH = 10;
+    constexpr int TILE_HEIGHT = 12;
+    constexpr const char* CHARSET = " .'`^\",:;Il!i><~+_-?][}{1)(|\\/tfjrxnuvczXYUJCLQ0OZmwqpdbkhao*#MW&8%B@$";
+
+    constexpr unsigned char COLUMN_BEGIN[70] = {
+        10, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 2, 2, 2, 2, 2,
+        1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2,
+    };
+
+    constexpr unsigned char COLUMN_END[70] = {
+        0, 4, 4, 5, 6, 5, 4, 4, 4, 4, 4, 4, 4, 6, 6, 7,
+        7, 8, 6, 7, 5, 5, 5, 5, 7, 6, 6, 4, 6, 6, 6, 6,
+        4, 6, 7, 7, 7, 7, 7, 7, 8, 8, 8, 7, 8, 7, 8, 7,
+        8, 7, 10, 9, 7, 7, 7, 7, 7, 7, 7, 7, 6, 8, 9, 9,
+        8, 7, 9, 8, 9, 7,
+    };
+
+    constexpr unsigned char ALPHA[8400] = {
+        // 0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 1
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 1, 1, 0, 0, 0, 0, 0, 0,
+        0, 0, 104, 143, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 2
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 8, 6, 0, 0, 0, 0, 0, 0,
+        0, 0, 124, 86, 0, 0, 0, 0, 0, 0,
+        0, 0, 81, 51, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 3
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 25, 40, 0, 0, 0, 0, 0, 0,
+        0, 0, 16, 166, 28, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 4
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 15, 5, 0, 0, 0, 0, 0,
+        0, 0, 37, 169, 157, 5, 0, 0, 0, 0,
+        0, 0, 5, 1, 5, 1, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 5
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 8, 7, 12, 0, 0, 0, 0, 0,
+        0, 0, 124, 126, 172, 0, 0, 0, 0, 0,
+        0, 0, 81, 65, 120, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 6
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+        0, 0, 103, 114, 0, 0, 0, 0, 0, 0,
+        0, 0, 86, 23, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 7
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 100, 145, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 100, 146, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 8
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 72, 171, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+        0, 0, 75, 141, 0, 0, 0, 0, 0, 0,
+        0, 0, 69, 39, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 9
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 64, 146, 0, 0, 0, 0, 0, 0,
+        0, 0, 67, 151, 0, 0, 0, 0, 0, 0,
+        0, 0, 67, 151, 0, 0, 0, 0, 0, 0,
+        0, 0, 67, 151, 0, 0, 0, 0, 0, 0,
+        0, 0, 67, 151, 0, 0, 0, 0, 0, 0,
+        0, 0, 65, 148, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 10
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 5, 6, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 111, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 112, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 112, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 112, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 112, 0, 0, 0, 0, 0, 0,
+        0, 0, 89, 109, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 11
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 85, 107, 0, 0, 0, 0, 0, 0,
+        0, 0, 89, 112, 0, 0, 0, 0, 0, 0,
+        0, 0, 89, 112, 0, 0, 0, 0, 0, 0,
+        0, 0, 89, 112, 0, 0, 0, 0, 0, 0,
+        0, 0, 49, 62, 0, 0, 0, 0, 0, 0,
+        0, 0, 97, 118, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 12
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 12, 14, 0, 0, 0, 0, 0, 0,
+        0, 0, 77, 88, 0, 0, 0, 0, 0, 0,
+        0, 0, 39, 46, 0, 0, 0, 0, 0, 0,
+        0, 0, 94, 109, 0, 0, 0, 0, 0, 0,
+        0, 0, 94, 109, 0, 0, 0, 0, 0, 0,
+        0, 0, 94, 109, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 107, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 13
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 85, 140, 8, 0, 0, 0, 0, 0,
+        0, 0, 0, 80, 190, 50, 0, 0, 0, 0,
+        0, 0, 0, 0, 83, 200, 0, 0, 0, 0,
+        0, 0, 8, 140, 158, 15, 0, 0, 0, 0,
+        0, 0, 77, 80, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 14
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1, 106, 128, 0, 0, 0, 0,
+        0, 0, 26, 176, 117, 3, 0, 0, 0, 0,
+        0, 0, 151, 133, 0, 0, 0, 0, 0, 0,
+        0, 0, 5, 128, 169, 21, 0, 0, 0, 0,
+        0, 0, 0, 0, 53, 109, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 15
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 9, 0, 1, 2, 0, 0, 0,
+        0, 0, 71, 178, 187, 188, 28, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 16
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 144, 1, 0, 0, 0, 0,
+        0, 0, 0, 0, 176, 1, 0, 0, 0, 0,
+        0, 0, 104, 168, 228, 168, 155, 0, 0, 0,
+        0, 0, 0, 0, 176, 1, 0, 0, 0, 0,
+        0, 0, 0, 0, 121, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 17
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 42, 92, 92, 92, 92, 78, 0, 0,
+        0, 0, 42, 92, 92, 92, 92, 78, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 18
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 71, 181, 181, 94, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 19
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 8, 0, 0, 0, 0, 0,
+        0, 0, 52, 201, 181, 182, 6, 0, 0, 0,
+        0, 0, 144, 50, 0, 178, 45, 0, 0, 0,
+        0, 0, 0, 0, 61, 189, 3, 0, 0, 0,
+        0, 0, 0, 4, 214, 21, 0, 0, 0, 0,
+        0, 0, 0, 15, 113, 0, 0, 0, 0, 0,
+        0, 0, 0, 38, 174, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 20
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 122, 163, 23, 0, 0, 0, 0, 0,
+        0, 0, 10, 161, 40, 0, 0, 0, 0, 0,
+        0, 0, 0, 154, 40, 0, 0, 0, 0, 0,
+        0, 0, 0, 154, 40, 0, 0, 0, 0, 0,
+        0, 0, 0, 154, 40, 0, 0, 0, 0, 0,
+        0, 0, 0, 154, 40, 0, 0, 0, 0, 0,
+        0, 0, 0, 154, 40, 0, 0, 0, 0, 0,
+        0, 0, 68, 190, 40, 0, 0, 0, 0, 0,
+        0, 0, 68, 92, 12, 0, 0, 0, 0, 0,
+        // 21
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 60, 163, 86, 0, 0, 0, 0, 0,
+        0, 0, 98, 108, 7, 0, 0, 0, 0, 0,
+        0, 0, 98, 98, 0, 0, 0, 0, 0, 0,
+        0, 0, 98, 98, 0, 0, 0, 0, 0, 0,
+        0, 0, 98, 98, 0, 0, 0, 0, 0, 0,
+        0, 0, 98, 98, 0, 0, 0, 0, 0, 0,
+        0, 0, 98, 98, 0, 0, 0, 0, 0, 0,
+        0, 0, 98, 155, 47, 0, 0, 0, 0, 0,
+        0, 0, 33, 92, 48, 0, 0, 0, 0, 0,
+        // 22
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 115, 66, 0, 0, 0, 0, 0, 0,
+        0, 0, 24, 201, 6, 0, 0, 0, 0, 0,
+        0, 0, 0, 165, 32, 0, 0, 0, 0, 0,
+        0, 0, 0, 135, 87, 0, 0, 0, 0, 0,
+        0, 0, 0, 59, 194, 0, 0, 0, 0, 0,
+        0, 0, 0, 144, 58, 0, 0, 0, 0, 0,
+        0, 0, 0, 170, 26, 0, 0, 0, 0, 0,
+        0, 0, 77, 199, 1, 0, 0, 0, 0, 0,
+        0, 0, 62, 22, 0, 0, 0, 0, 0, 0,
+        // 23
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 49, 135, 0, 0, 0, 0, 0,
+        0, 0, 0, 195, 35, 0, 0, 0, 0, 0,
+        0, 0, 1, 194, 0, 0, 0, 0, 0, 0,
+        0, 0, 52, 166, 0, 0, 0, 0, 0, 0,
+        0, 0, 158, 95, 0, 0, 0, 0, 0, 0,
+        0, 0, 22, 184, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 195, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 177, 99, 0, 0, 0, 0, 0,
+        0, 0, 0, 13, 71, 0, 0, 0, 0, 0,
+        // 24
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 63, 229, 61, 0, 0, 0, 0,
+        0, 0, 29, 174, 169, 64, 0, 0, 0, 0,
+        0, 0, 0, 0, 150, 64, 0, 0, 0, 0,
+        0, 0, 0, 0, 150, 64, 0, 0, 0, 0,
+        0, 0, 0, 0, 150, 64, 0, 0, 0, 0,
+        0, 0, 40, 190, 228, 206, 143, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 25
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 95, 169, 8, 0, 0, 0, 0,
+        0, 0, 0, 0, 109, 88, 0, 0, 0, 0,
+        0, 0, 0, 0, 49, 140, 0, 0, 0, 0,
+        0, 0, 0, 0, 33, 157, 0, 0, 0, 0,
+        0, 0, 0, 0, 33, 157, 0, 0, 0, 0,
+        0, 0, 0, 0, 49, 140, 0, 0, 0, 0,
+        0, 0, 0, 0, 108, 89, 0, 0, 0, 0,
+        0, 0, 0, 94, 171, 9, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 26
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 123, 149, 0, 0, 0, 0,
+        0, 0, 0, 18, 178, 0, 0, 0, 0, 0,
+        0, 0, 0, 68, 121, 0, 0, 0, 0, 0,
+        0, 0, 0, 84, 106, 0, 0, 0, 0, 0,
+        0, 0, 0, 84, 106, 0, 0, 0, 0, 0,
+        0, 0, 0, 68, 120, 0, 0, 0, 0, 0,
+        0, 0, 0, 19, 177, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 125, 147, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 27
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 61, 57, 0, 0, 0, 0, 0, 0,
+        0, 0, 96, 90, 0, 0, 0, 0, 0, 0,
+        0, 0, 96, 90, 0, 0, 0, 0, 0, 0,
+        0, 0, 96, 90, 0, 0, 0, 0, 0, 0,
+        0, 0, 96, 90, 0, 0, 0, 0, 0, 0,
+        0, 0, 96, 90, 0, 0, 0, 0, 0, 0,
+        0, 0, 96, 90, 0, 0, 0, 0, 0, 0,
+        0, 0, 96, 90, 0, 0, 0, 0, 0, 0,
+        0, 0, 96, 90, 0, 0, 0, 0, 0, 0,
+        0, 0, 72, 67, 0, 0, 0, 0, 0, 0,
+        // 28
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 124, 10, 0, 0, 0, 0, 0, 0,
+        0, 0, 95, 99, 0, 0, 0, 0, 0, 0,
+        0, 0, 8, 185, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 137, 56, 0, 0, 0, 0, 0,
+        0, 0, 0, 33, 160, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 171, 21, 0, 0, 0, 0,
+        0, 0, 0, 0, 72, 120, 0, 0, 0, 0,
+        0, 0, 0, 0, 2, 130, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 29
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 1, 131, 0, 0, 0, 0,
+        0, 0, 0, 0, 70, 122, 0, 0, 0, 0,
+        0, 0, 0, 0, 169, 22, 0, 0, 0, 0,
+        0, 0, 0, 31, 161, 0, 0, 0, 0, 0,
+        0, 0, 0, 134, 57, 0, 0, 0, 0, 0,
+        0, 0, 7, 184, 0, 0, 0, 0, 0, 0,
+        0, 0, 92, 99, 0, 0, 0, 0, 0, 0,
+        0, 0, 122, 10, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 30
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 11, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 199, 0, 0, 0, 0, 0, 0,
+        0, 0, 94, 225, 114, 6, 0, 0, 0, 0,
+        0, 0, 48, 213, 59, 2, 0, 0, 0, 0,
+        0, 0, 0, 201, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 204, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 153, 184, 21, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 31
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 18, 77, 18, 0, 0, 0, 0,
+        0, 0, 0, 190, 106, 20, 0, 0, 0, 0,
+        0, 0, 94, 226, 114, 16, 0, 0, 0, 0,
+        0, 0, 48, 213, 60, 7, 0, 0, 0, 0,
+        0, 0, 0, 201, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 201, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 196, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 32
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 9, 18, 0, 0, 0, 0, 0, 0,
+        0, 0, 62, 106, 0, 0, 0, 0, 0, 0,
+        0, 0, 29, 57, 0, 0, 0, 0, 0, 0,
+        0, 0, 72, 133, 0, 0, 0, 0, 0, 0,
+        0, 0, 72, 133, 0, 0, 0, 0, 0, 0,
+        0, 0, 72, 133, 0, 0, 0, 0, 0, 0,
+        0, 0, 72, 133, 0, 0, 0, 0, 0, 0,
+        0, 2, 109, 115, 0, 0, 0, 0, 0, 0,
+        0, 44, 135, 13, 0, 0, 0, 0, 0, 0,
+        // 33
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 39, 66, 105, 14, 0, 0, 0, 0,
+        0, 0, 94, 207, 84, 9, 0, 0, 0, 0,
+        0, 0, 94, 118, 0, 0, 0, 0, 0, 0,
+        0, 0, 94, 114, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 111, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 34
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 70, 27, 0, 69, 25, 0, 0, 0,
+        0, 0, 45, 189, 56, 180, 3, 0, 0, 0,
+        0, 0, 0, 112, 235, 22, 0, 0, 0, 0,
+        0, 0, 6, 190, 171, 98, 0, 0, 0, 0,
+        0, 0, 135, 95, 5, 187, 40, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 35
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 39, 65, 115, 89, 0, 0, 0, 0,
+        0, 0, 94, 209, 68, 173, 90, 0, 0, 0,
+        0, 0, 94, 122, 0, 65, 145, 0, 0, 0,
+        0, 0, 94, 114, 0, 58, 149, 0, 0, 0,
+        0, 0, 91, 111, 0, 55, 147, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 36
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 44, 43, 0, 32, 55, 0, 0, 0,
+        0, 0, 104, 103, 0, 77, 130, 0, 0, 0,
+        0, 0, 104, 103, 0, 77, 130, 0, 0, 0,
+        0, 0, 88, 131, 0, 111, 130, 0, 0, 0,
+        0, 0, 18, 199, 175, 189, 127, 0, 0, 0,
+        0, 0, 0, 0, 8, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 37
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 79, 10, 0, 40, 48, 0, 0, 0,
+        0, 0, 115, 94, 0, 163, 45, 0, 0, 0,
+        0, 0, 20, 185, 16, 189, 0, 0, 0, 0,
+        0, 0, 0, 165, 143, 97, 0, 0, 0, 0,
+        0, 0, 0, 62, 235, 10, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 38
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 70, 124, 62, 0, 0, 0, 0,
+        0, 0, 72, 180, 58, 194, 49, 0, 0, 0,
+        0, 0, 139, 76, 0, 8, 5, 0, 0, 0,
+        0, 0, 119, 102, 0, 72, 39, 0, 0, 0,
+        0, 0, 26, 192, 169, 194, 17, 0, 0, 0,
+        0, 0, 0, 0, 12, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 39
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 63, 115, 115, 96, 0, 0, 0, 0,
+        0, 0, 32, 60, 152, 153, 0, 0, 0, 0,
+        0, 0, 0, 51, 196, 8, 0, 0, 0, 0,
+        0, 0, 20, 205, 32, 0, 0, 0, 0, 0,
+        0, 0, 149, 217, 172, 170, 4, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 40
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 123, 115, 0, 25, 200, 6, 0, 0,
+        0, 0, 5, 198, 49, 179, 63, 0, 0, 0,
+        0, 0, 0, 41, 230, 139, 0, 0, 0, 0,
+        0, 0, 0, 54, 227, 155, 0, 0, 0, 0,
+        0, 0, 12, 204, 34, 175, 82, 0, 0, 0,
+        0, 0, 147, 92, 0, 20, 209, 19, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 41
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 142, 76, 0, 1, 187, 30, 0, 0,
+        0, 0, 20, 204, 9, 95, 136, 0, 0, 0,
+        0, 0, 0, 108, 143, 206, 12, 0, 0, 0,
+        0, 0, 0, 4, 213, 94, 0, 0, 0, 0,
+        0, 0, 0, 0, 169, 47, 0, 0, 0, 0,
+        0, 0, 0, 0, 167, 44, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 42
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 77, 129, 0, 0, 131, 74, 0, 0,
+        0, 0, 80, 133, 0, 0, 136, 78, 0, 0,
+        0, 0, 80, 133, 0, 0, 136, 78, 0, 0,
+        0, 0, 78, 137, 0, 0, 140, 75, 0, 0,
+        0, 0, 38, 198, 0, 0, 201, 35, 0, 0,
+        0, 0, 1, 142, 205, 205, 140, 0, 0, 0,
+        0, 0, 0, 0, 5, 5, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 43
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 64, 190, 190, 198, 181, 0, 0, 0,
+        0, 0, 0, 0, 0, 32, 187, 0, 0, 0,
+        0, 0, 0, 0, 0, 32, 187, 0, 0, 0,
+        0, 0, 0, 0, 0, 33, 186, 0, 0, 0,
+        0, 0, 138, 66, 0, 87, 148, 0, 0, 0,
+        0, 0, 46, 204, 181, 203, 32, 0, 0, 0,
+        0, 0, 0, 0, 11, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 44
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 5, 3, 0, 0, 0, 0,
+        0, 0, 3, 158, 196, 201, 135, 0, 0, 0,
+        0, 0, 78, 165, 0, 1, 194, 49, 0, 0,
+        0, 0, 123, 98, 0, 0, 1, 0, 0, 0,
+        0, 0, 123, 97, 0, 0, 0, 0, 0, 0,
+        0, 0, 80, 163, 0, 1, 190, 50, 0, 0,
+        0, 0, 5, 162, 193, 199, 141, 0, 0, 0,
+        0, 0, 0, 0, 6, 4, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 45
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 64, 144, 0, 0, 0, 0, 0, 0,
+        0, 0, 67, 149, 0, 0, 0, 0, 0, 0,
+        0, 0, 67, 149, 0, 0, 0, 0, 0, 0,
+        0, 0, 67, 149, 0, 0, 0, 0, 0, 0,
+        0, 0, 67, 149, 0, 0, 0, 0, 0, 0,
+        0, 0, 65, 228, 190, 190, 113, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 46
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 5, 2, 0, 0, 0, 0,
+        0, 0, 4, 156, 185, 195, 111, 0, 0, 0,
+        0, 0, 73, 157, 0, 4, 206, 19, 0, 0,
+        0, 0, 120, 99, 0, 0, 153, 66, 0, 0,
+        0, 0, 121, 100, 0, 0, 154, 65, 0, 0,
+        0, 0, 77, 169, 0, 1, 210, 10, 0, 0,
+        0, 0, 6, 167, 196, 209, 197, 0, 0, 0,
+        0, 0, 0, 0, 7, 3, 105, 21, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 47
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 8, 0, 0, 0, 0, 0,
+        0, 0, 11, 188, 197, 255, 47, 0, 0, 0,
+        0, 0, 101, 143, 17, 192, 171, 0, 0, 0,
+        0, 0, 136, 85, 109, 42, 208, 0, 0, 0,
+        0, 0, 136, 86, 138, 12, 208, 0, 0, 0,
+        0, 0, 101, 211, 68, 68, 174, 0, 0, 0,
+        0, 0, 13, 255, 195, 216, 50, 0, 0, 0,
+        0, 0, 0, 0, 10, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 48
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 5, 2, 0, 0, 0, 0,
+        0, 0, 4, 156, 185, 195, 112, 0, 0, 0,
+        0, 0, 73, 157, 0, 4, 207, 20, 0, 0,
+        0, 0, 120, 99, 0, 0, 153, 66, 0, 0,
+        0, 0, 121, 100, 0, 0, 154, 66, 0, 0,
+        0, 0, 77, 169, 0, 1, 222, 22, 0, 0,
+        0, 0, 6, 167, 196, 208, 125, 0, 0, 0,
+        0, 0, 0, 0, 7, 3, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 49
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 105, 190, 190, 217, 165, 0, 0, 0,
+        0, 0, 0, 0, 11, 206, 46, 0, 0, 0,
+        0, 0, 0, 0, 157, 109, 0, 0, 0, 0,
+        0, 0, 0, 89, 179, 1, 0, 0, 0, 0,
+        0, 0, 35, 216, 21, 0, 0, 0, 0, 0,
+        0, 0, 156, 224, 190, 190, 144, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 50
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 39, 73, 114, 22, 54, 119, 33, 0,
+        0, 0, 94, 192, 58, 203, 144, 70, 197, 0,
+        0, 0, 94, 114, 0, 150, 60, 0, 201, 3,
+        0, 0, 94, 109, 0, 145, 56, 0, 199, 4,
+        0, 0, 91, 107, 0, 143, 53, 0, 194, 3,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 51
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 74, 10, 1, 86, 0, 27, 58, 0,
+        0, 0, 119, 79, 53, 244, 18, 118, 82, 0,
+        0, 0, 41, 154, 133, 127, 95, 185, 12, 0,
+        0, 0, 0, 192, 177, 11, 182, 176, 0, 0,
+        0, 0, 0, 137, 132, 0, 170, 100, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 52
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 82, 119, 64, 49, 0, 0, 0,
+        0, 0, 80, 175, 59, 193, 115, 0, 0, 0,
+        0, 0, 140, 73, 0, 96, 115, 0, 0, 0,
+        0, 0, 125, 94, 0, 118, 115, 0, 0, 0,
+        0, 0, 31, 203, 168, 196, 115, 0, 0, 0,
+        0, 0, 0, 1, 8, 91, 115, 0, 0, 0,
+        0, 0, 0, 0, 0, 54, 69, 0, 0, 0,
+        // 53
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 38, 66, 117, 93, 1, 0, 0, 0,
+        0, 0, 91, 208, 61, 158, 103, 0, 0, 0,
+        0, 0, 91, 119, 0, 48, 163, 0, 0, 0,
+        0, 0, 91, 141, 0, 70, 149, 0, 0, 0,
+        0, 0, 91, 203, 167, 205, 44, 0, 0, 0,
+        0, 0, 91, 114, 7, 2, 0, 0, 0, 0,
+        0, 0, 55, 68, 0, 0, 0, 0, 0, 0,
+        // 54
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 5, 6, 0, 0, 0,
+        0, 0, 0, 0, 0, 92, 114, 0, 0, 0,
+        0, 0, 0, 80, 119, 120, 115, 0, 0, 0,
+        0, 0, 79, 173, 59, 194, 115, 0, 0, 0,
+        0, 0, 141, 70, 0, 97, 115, 0, 0, 0,
+        0, 0, 126, 92, 0, 123, 115, 0, 0, 0,
+        0, 0, 30, 202, 168, 194, 112, 0, 0, 0,
+        0, 0, 0, 1, 8, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 55
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 5, 6, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 113, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 134, 116, 90, 1, 0, 0, 0,
+        0, 0, 91, 208, 61, 158, 100, 0, 0, 0,
+        0, 0, 91, 118, 0, 48, 162, 0, 0, 0,
+        0, 0, 91, 144, 0, 70, 147, 0, 0, 0,
+        0, 0, 89, 200, 168, 205, 43, 0, 0, 0,
+        0, 0, 0, 0, 8, 2, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 56
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 5, 6, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 109, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 109, 6, 102, 5, 0, 0, 0,
+        0, 0, 91, 130, 182, 80, 0, 0, 0, 0,
+        0, 0, 91, 253, 77, 0, 0, 0, 0, 0,
+        0, 0, 91, 154, 199, 34, 0, 0, 0, 0,
+        0, 0, 89, 107, 38, 196, 27, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 57
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 5, 7, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 117, 0, 0, 0, 0, 0, 0,
+        0, 0, 91, 135, 115, 91, 1, 0, 0, 0,
+        0, 0, 91, 213, 68, 170, 97, 0, 0, 0,
+        0, 0, 91, 126, 0, 63, 152, 0, 0, 0,
+        0, 0, 91, 118, 0, 56, 156, 0, 0, 0,
+        0, 0, 89, 115, 0, 53, 153, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 58
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 1, 86, 125, 50, 0, 0, 0, 0,
+        0, 0, 55, 123, 46, 208, 10, 0, 0, 0,
+        0, 0, 10, 102, 150, 221, 32, 0, 0, 0,
+        0, 0, 131, 87, 1, 202, 32, 0, 0, 0,
+        0, 0, 86, 181, 164, 219, 29, 0, 0, 0,
+        0, 0, 0, 7, 4, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 59
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 67, 121, 55, 0, 0, 0, 0,
+        0, 0, 70, 179, 59, 192, 47, 0, 0, 0,
+        0, 0, 137, 74, 0, 99, 112, 0, 0, 0,
+        0, 0, 119, 101, 0, 126, 94, 0, 0, 0,
+        0, 0, 25, 191, 170, 182, 15, 0, 0, 0,
+        0, 0, 0, 0, 8, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 60
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 30, 18, 0, 0, 0, 0, 0,
+        0, 0, 65, 163, 142, 37, 0, 0, 0, 0,
+        0, 0, 35, 206, 190, 17, 0, 0, 0, 0,
+        0, 0, 11, 69, 80, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 61
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 98, 5, 94, 0, 0, 0,
+        0, 0, 33, 110, 194, 119, 185, 50, 0, 0,
+        0, 0, 24, 123, 148, 133, 137, 36, 0, 0,
+        0, 0, 29, 132, 115, 144, 104, 14, 0, 0,
+        0, 0, 66, 197, 131, 205, 123, 33, 0, 0,
+        0, 0, 0, 106, 4, 109, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 62
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 64, 193, 0, 0, 14, 230, 11, 0,
+        0, 0, 67, 245, 75, 0, 127, 245, 13, 0,
+        0, 0, 67, 155, 189, 21, 183, 195, 13, 0,
+        0, 0, 67, 140, 121, 206, 66, 195, 13, 0,
+        0, 0, 67, 140, 11, 118, 0, 195, 13, 0,
+        0, 0, 65, 137, 0, 0, 0, 191, 11, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 63
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 140, 63, 0, 0, 0, 103, 101, 0,
+        0, 0, 95, 117, 9, 143, 0, 157, 55, 0,
+        0, 0, 44, 167, 76, 237, 36, 203, 9, 0,
+        0, 0, 3, 207, 153, 97, 121, 204, 0, 0,
+        0, 0, 0, 196, 180, 4, 215, 158, 0, 0,
+        0, 0, 0, 144, 114, 0, 155, 104, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 64
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 6, 0, 0, 0, 0, 0,
+        0, 0, 0, 160, 172, 171, 0, 0, 0, 0,
+        0, 0, 3, 198, 0, 188, 12, 0, 0, 0,
+        0, 0, 0, 148, 194, 106, 5, 14, 0, 0,
+        0, 0, 49, 189, 158, 107, 101, 98, 0, 0,
+        0, 0, 117, 90, 1, 155, 218, 16, 0, 0,
+        0, 0, 32, 190, 165, 189, 163, 105, 0, 0,
+        0, 0, 0, 0, 10, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 65
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 8, 0, 0, 0, 0, 0,
+        0, 0, 17, 185, 170, 196, 54, 0, 0, 0,
+        0, 0, 80, 129, 0, 56, 151, 0, 0, 0,
+        0, 0, 22, 207, 138, 203, 71, 0, 0, 0,
+        0, 0, 81, 173, 58, 122, 152, 0, 0, 0,
+        0, 0, 135, 85, 0, 16, 202, 0, 0, 0,
+        0, 0, 34, 197, 166, 195, 77, 0, 0, 0,
+        0, 0, 0, 0, 12, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 66
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+        0, 0, 74, 157, 127, 0, 65, 126, 0, 0,
+        0, 0, 148, 10, 160, 24, 174, 5, 0, 0,
+        0, 0, 73, 140, 126, 171, 30, 0, 0, 0,
+        0, 0, 0, 0, 130, 107, 165, 156, 0, 0,
+        0, 0, 0, 72, 131, 97, 63, 138, 22, 0,
+        0, 0, 20, 169, 3, 36, 160, 154, 1, 0,
+        0, 0, 0, 0, 0, 0, 2, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 67
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 64, 220, 177, 190, 144, 0, 0, 0,
+        0, 0, 67, 146, 0, 0, 215, 17, 0, 0,
+        0, 0, 67, 195, 114, 142, 189, 1, 0, 0,
+        0, 0, 67, 172, 60, 86, 209, 11, 0, 0,
+        0, 0, 67, 146, 0, 0, 187, 42, 0, 0,
+        0, 0, 65, 222, 177, 190, 151, 1, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        // 68
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 23, 132, 156, 140, 40, 0, 0,
+        0, 0, 15, 178, 35, 6, 25, 172, 38, 0,
+        0, 0, 96, 74, 127, 158, 202, 45, 125, 0,
+        0, 0, 131, 28, 153, 0, 174, 9, 150, 0,
+        0, 0, 113, 56, 155, 73, 226, 110, 115, 0,
+        0, 0, 37, 169, 18, 88, 28, 110, 9, 0,
+        0, 0, 0, 81, 183, 156, 156, 119, 2, 0,
+        0, 0, 0, 0, 0, 1, 0, 0, 0, 0,
+        // 69
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 150, 1, 0, 0, 0, 0,
+        0, 0, 20, 175, 184, 201, 59, 0, 0, 0,
+        0, 0, 103, 120, 0, 36, 113, 0, 0, 0,
+        0, 0, 41, 208, 123, 34, 0, 0, 0, 0,
+        0, 0, 0, 7, 81, 181, 132, 0, 0, 0,
+        0, 0, 100, 48, 0, 15, 215, 0, 0, 0,
+        0, 0, 44, 196, 176, 201, 94, 0, 0, 0,
+        0, 0, 0, 0, 154, 2, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+}
+
+#endif
@@ -0,0 +1,538 @@
+/*
+ * ASCII字符网格
+ * 分析阶段与渲染、编码阶段之间的帧数据：每个字符格的字形编号、颜色和标志，
+ * 按平面（结构数组）存放，并定义网格文件（.mgrid）的读写格式
+ *
+ * 只依赖标准库和zlib（帧记录的deflate压缩），转换器和独立播放器共用
+ *
+ * 作者: miku-01-hein + GPT
+ */
+
+#ifndef MIKU_GRID_H
+#define MIKU_GRID_H
+
+#include <cstdint>               // 定宽整数类型
+#include <cstring>               // 内存拷贝、比较
+#include <istream>               // 网格文件读取
+#include <ostream>               // 网格文件写入
+#include <string>                // 字符集字符串
+#include <vector>                // 平面存储
+#include <zlib.h>                // 帧记录deflate压缩
+
+/*
+ * 网格文件格式常量
+ * 所有整数按小端序存放
+ */
+namespace GridFormat {
+    // 文件头标识 "MGRD" 和格式版本
+    constexpr uint32_t FILE_MAGIC = 0x4452474D;
+    constexpr uint16_t FILE_VERSION = 1;
+
+    // 文件头渲染模式标志：背景填充（--background-fill）、背景上叠加字符（glyph，none时不叠加）、
+    // 覆盖率补偿（--coverage-comp）；网格只记录字形和颜色，这些模式决定怎样把它画出来
+    constexpr uint8_t MODE_BACKGROUND_FILL = 1;
+    constexpr uint8_t MODE_BACKGROUND_GLYPHS = 2;
+    constexpr uint8_t MODE_COVERAGE_COMPENSATION = 4;
+
+    // 帧记录标识 "GFRM"
+    constexpr uint32_t FRAME_MAGIC = 0x4D524647;
+
+    // 帧类型：原始帧，字形、B、G、R四个平面经deflate压缩，格式见 appendGridFrame
+    constexpr uint32_t FRAME_RAW = 0;
+
+    // 帧类型：帧间预测帧，只记录与上一帧不同的字符格，颜色记为与上一帧的差值，格式见 appendGridDelta
+    constexpr uint32_t FRAME_DELTA = 1;
+
+    // deflate压缩级别：240帧120x56的实测中，级别1比6大3%（编码每帧0.8毫秒对1.5毫秒），
+    // 级别9与6相差不到0.1%
+    constexpr int DEFLATE_LEVEL = 6;
+
+    // 文件头中字形图块宽度的上限（像素），超过时视为损坏
+    constexpr int MAX_TILE_WIDTH = 64;
+
+    // 平面行宽对齐（字节），等于缓存行大小
+    constexpr int PLANE_ALIGNMENT = 64;
+}
+
+/*
+ * AsciiGrid类
+ * 结构数组形式的字符网格：字形编号、B、G、R、标志五个平面，
+ * 每个平面的每一行都从64字节边界开始，相邻行、相邻平面不共享缓存行，
+ * 分析和渲染都按行连续访问单个平面，便于编译器向量化，帧间比较也只是逐行比较字节
+ */
+class AsciiGrid {
+public:
+    // 标志位：本字符格与上一帧不同
+    static constexpr uint8_t FLAG_CHANGED = 1;
+
+    // 平面编号
+    enum Plane { GLYPH = 0, BLUE = 1, GREEN = 2, RED = 3, FLAGS = 4, PLANE_COUNT = 5 };
+
+private:
+    // 按缓存行对齐的存储块，vector<Block> 的数据起点即为64字节对齐
+    struct alignas(GridFormat::PLANE_ALIGNMENT) Block {
+        uint8_t bytes[GridFormat::PLANE_ALIGNMENT];
+    };
+
+    int width;                   // 列数（字符格）
+    int height;                  // 行数（字符格）
+    int stride;                  // 平面行宽（字节，对齐到64）
+    std::vector<Block> storage;  // 五个平面连续存放
+
+public:
+    AsciiGrid() : width(0), height(0), stride(0) {}
+
+    /*
+     * 调整网格大小函数
+     * 尺寸不变时保留现有内容（隔行更新依赖这一点），尺寸变化时全部清零
+     */
+    void resize(int gridWidth, int gridHeight) {
+        if (gridWidth == width && gridHeight == height) {
+            return;
+        }
+        width = gridWidth;
+        height = gridHeight;
+        stride = (width + GridFormat::PLANE_ALIGNMENT - 1) / GridFormat::PLANE_ALIGNMENT * GridFormat::PLANE_ALIGNMENT;
+        size_t bytes = static_cast<size_t>(stride) * height * PLANE_COUNT;
+        storage.assign(bytes / GridFormat::PLANE_ALIGNMENT, Block());
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    bool empty() const { return width == 0 || height == 0; }
+
+    // 第plane个平面第y行的起始地址
+    uint8_t* row(Plane plane, int y) {
+        return storage.front().bytes + (static_cast<size_t>(plane) * height + y) * stride;
+    }
+    const uint8_t* row(Plane plane, int y) const {
+        return storage.front().bytes + (static_cast<size_t>(plane) * height + y) * stride;
+    }
+
+    /*
+     * 帧间比较函数
+     * 与上一帧逐格比较字形和颜色，不同的字符格设置FLAG_CHANGED，相同的清除该标志
+     *
+     * 返回值：
+     *   int: 变化的字符格数量；尺寸不同（或上一帧为空）时视为全部变化
+     */
+    int markChanges(const AsciiGrid& previous) {
+        const bool comparable = previous.width == width && previous.height == height;
+        int changed = 0;
+        for (int y = 0; y < height; ++y) {
+            uint8_t* flags = row(FLAGS, y);
+            if (!comparable) {
+                std::memset(flags, FLAG_CHANGED, width);
+                changed += width;
+                continue;
+            }
+            const uint8_t* planes[4] = {row(GLYPH, y), row(BLUE, y), row(GREEN, y), row(RED, y)};
+            const uint8_t* before[4] = {previous.row(GLYPH, y), previous.row(BLUE, y),
+                                        previous.row(GREEN, y), previous.row(RED, y)};
+            for (int x = 0; x < width; ++x) {
+                uint8_t differs = (planes[0][x] != before[0][x]) | (planes[1][x] != before[1][x]) |
+                                  (planes[2][x] != before[2][x]) | (planes[3][x] != before[3][x]);
+                flags[x] = static_cast<uint8_t>((flags[x] & ~FLAG_CHANGED) | differs);
+                changed += differs;
+            }
+        }
+        return changed;
+    }
+
+    // 拷贝另一个网格的全部内容（尺寸相同时不重新分配）
+    void copyFrom(const AsciiGrid& other) {
+        resize(other.width, other.height);
+        storage = other.storage;
+    }
+};
+
+/*
+ * 网格文件头
+ * 文件开头写一次，随后是若干帧记录
+ */
+struct GridFileHeader {
+    uint16_t width = 0;          // 网格列数
+    uint16_t height = 0;         // 网格行数
+    uint16_t cellWidth = 0;      // 每个字形的像素宽度（全角字符集为两个字符格）
+    uint16_t cellHeight = 0;     // 每个字形的像素高度
+    uint32_t fpsMilli = 0;       // 帧率 x 1000
+    uint8_t mono = 0;            // 1表示灰度输出
+    uint8_t modes = 0;           // 渲染模式标志（GridFormat::MODE_*）
+    std::string charset;         // 字符集（UTF-8），字形编号即字符在其中的位置
+    uint16_t tileWidth = 0;      // 字形图块宽度（含左右留白）
+    std::vector<uint8_t> glyphAlpha;  // 字形图集：每个字形一块 tileWidth x cellHeight 的透明度，按字形编号排列
+};
+
+/*
+ * 小端序读写辅助函数
+ */
+inline void writeLE(std::ostream& out, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+inline uint32_t readLE(std::istream& in, int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(in.get())) << (8 * i);
+    }
+    return value;
+}
+
+/*
+ * 写网格文件头函数
+ * 布局：标识(4) 版本(2) 宽(2) 高(2) 字形宽(2) 字形高(2) 帧率x1000(4) 灰度(1) 渲染模式(1) 字符集长度(4) 字符集
+ *       图块宽(2) 图集长度(4) 压缩后长度(4) 图集（zlib压缩）
+ * 图集是转换时实际绘制的字形（任意字符集、--font 字体），播放器不需要自己的字形就能按原样绘制
+ */
+inline bool writeGridHeader(std::ostream& out, const GridFileHeader& header) {
+    writeLE(out, GridFormat::FILE_MAGIC, 4);
+    writeLE(out, GridFormat::FILE_VERSION, 2);
+    writeLE(out, header.width, 2);
+    writeLE(out, header.height, 2);
+    writeLE(out, header.cellWidth, 2);
+    writeLE(out, header.cellHeight, 2);
+    writeLE(out, header.fpsMilli, 4);
+    writeLE(out, header.mono, 1);
+    writeLE(out, header.modes, 1);
+    writeLE(out, static_cast<uint32_t>(header.charset.size()), 4);
+    out.write(header.charset.data(), static_cast<std::streamsize>(header.charset.size()));
+
+    uLongf packed = compressBound(static_cast<uLong>(header.glyphAlpha.size()));
+    std::vector<uint8_t> tiles(packed);
+    compress2(tiles.data(), &packed, header.glyphAlpha.data(), static_cast<uLong>(header.glyphAlpha.size()),
+              GridFormat::DEFLATE_LEVEL);
+    writeLE(out, header.tileWidth, 2);
+    writeLE(out, static_cast<uint32_t>(header.glyphAlpha.size()), 4);
+    writeLE(out, static_cast<uint32_t>(packed), 4);
+    out.write(reinterpret_cast<const char*>(tiles.data()), static_cast<std::streamsize>(packed));
+    return static_cast<bool>(out);
+}
+
+/*
+ * 读网格文件头函数
+ * 返回值：标识或版本不符、文件截断、缺少字形图集或图集损坏时返回false
+ */
+inline bool readGridHeader(std::istream& in, GridFileHeader& header) {
+    if (readLE(in, 4) != GridFormat::FILE_MAGIC) {
+        return false;
+    }
+    if (readLE(in, 2) != GridFormat::FILE_VERSION) {
+        return false;
+    }
+    header.width = static_cast<uint16_t>(readLE(in, 2));
+    header.height = static_cast<uint16_t>(readLE(in, 2));
+    header.cellWidth = static_cast<uint16_t>(readLE(in, 2));
+    header.cellHeight = static_cast<uint16_t>(readLE(in, 2));
+    header.fpsMilli = readLE(in, 4);
+    header.mono = static_cast<uint8_t>(readLE(in, 1));
+    header.modes = static_cast<uint8_t>(readLE(in, 1));
+    uint32_t charsetBytes = readLE(in, 4);
+    if (!in || charsetBytes > 4096) {
+        return false;
+    }
+    header.charset.resize(charsetBytes);
+    in.read(&header.charset[0], charsetBytes);
+
+    // 字形图集：整数个图块，字形数不超过256，图块大小有上限（与字符集字形数是否一致由调用方检查）
+    header.tileWidth = static_cast<uint16_t>(readLE(in, 2));
+    uLongf alphaBytes = readLE(in, 4);
+    uint32_t packed = readLE(in, 4);
+    const uLong tileBytes = static_cast<uLong>(header.tileWidth) * header.cellHeight;
+    if (!in || header.tileWidth < header.cellWidth || header.tileWidth > GridFormat::MAX_TILE_WIDTH ||
+        tileBytes == 0 || alphaBytes == 0 || alphaBytes % tileBytes != 0 || alphaBytes > 256 * tileBytes ||
+        packed > compressBound(alphaBytes)) {
+        return false;
+    }
+    std::vector<uint8_t> tiles(packed);
+    if (!in.read(reinterpret_cast<char*>(tiles.data()), packed)) {
+        return false;
+    }
+    header.glyphAlpha.resize(alphaBytes);
+    return uncompress(header.glyphAlpha.data(), &alphaBytes, tiles.data(), packed) == Z_OK &&
+           alphaBytes == header.glyphAlpha.size();
+}
+
+/*
+ * 压缩帧记录函数
+ * 把解压后的数据body压缩成一条帧记录追加到缓冲区：
+ * 标识(4) 类型(4) 数据长度(4)，数据为 解压后长度(4) + zlib数据
+ */
+inline void appendDeflateRecord(std::vector<uint8_t>& out, uint32_t type, const std::vector<uint8_t>& body) {
+    const size_t start = out.size();
+    uLongf packed = compressBound(static_cast<uLong>(body.size()));
+    out.resize(start + 16 + packed);
+    compress2(out.data() + start + 16, &packed, body.data(), static_cast<uLong>(body.size()), GridFormat::DEFLATE_LEVEL);
+    out.resize(start + 16 + packed);
+
+    const uint32_t fields[4] = {GridFormat::FRAME_MAGIC, type, static_cast<uint32_t>(4 + packed),
+                                static_cast<uint32_t>(body.size())};
+    for (int f = 0; f < 4; ++f) {
+        for (int i = 0; i < 4; ++i) {
+            out[start + f * 4 + i] = static_cast<uint8_t>((fields[f] >> (8 * i)) & 0xFF);
+        }
+    }
+}
+
+/*
+ * 编码原始帧函数
+ * 把字形、B、G、R四个平面（去掉行填充）依次排列后压缩，追加一条FRAME_RAW帧记录；
+ * 异步写出时直接编码到写出缓冲区，不经过流
+ */
+inline void appendGridFrame(std::vector<uint8_t>& out, const AsciiGrid& grid) {
+    const int w = grid.getWidth();
+    const int h = grid.getHeight();
+    std::vector<uint8_t> body;
+    body.reserve(static_cast<size_t>(w) * h * 4);
+    for (int plane = AsciiGrid::GLYPH; plane <= AsciiGrid::RED; ++plane) {
+        for (int y = 0; y < h; ++y) {
+            const uint8_t* src = grid.row(static_cast<AsciiGrid::Plane>(plane), y);
+            body.insert(body.end(), src, src + w);
+        }
+    }
+    appendDeflateRecord(out, GridFormat::FRAME_RAW, body);
+}
+
+/*
+ * 写原始帧函数
+ * 帧记录格式同appendGridFrame
+ */
+inline bool writeGridFrame(std::ostream& out, const AsciiGrid& grid) {
+    std::vector<uint8_t> record;
+    appendGridFrame(record, grid);
+    out.write(reinterpret_cast<const char*>(record.data()), static_cast<std::streamsize>(record.size()));
+    return static_cast<bool>(out);
+}
+
+/*
+ * 内存中的小端序读取和LEB128变长整数读写辅助函数
+ */
+inline uint32_t loadLE(const uint8_t* data, int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint32_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+inline void appendVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// 返回值：读取成功返回true；数据不足或超过5字节时返回false
+inline bool loadVarint(const uint8_t*& data, const uint8_t* end, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35 && data < end; shift += 7) {
+        uint8_t byte = *data++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * 编码帧间预测帧函数
+ * 按FLAGS平面（markChanges的结果）只记录与上一帧不同的字符格，解压后的数据为：
+ *   游程段长度(4)，游程段为若干 (跳过数, 字符格数) 对（LEB128变长整数），按行优先顺序覆盖整幅网格；
+ *   随后是全部变化字符格的字形，再是它们的B、G、R与reference（上一帧）的差值（模256），各自连续存放
+ * 字符格颜色逐帧缓慢变化，差值集中在0附近，分平面存放后deflate能压缩掉大部分
+ *
+ * 参数：
+ *   reference: 上一帧写出的网格（解码端的当前状态）
+ *
+ * 返回值：
+ *   bool: 预测帧的数据比原始帧小时追加FRAME_DELTA记录并返回true；
+ *         否则不追加任何内容并返回false，由调用方改写原始帧
+ */
+inline bool appendGridDelta(std::vector<uint8_t>& out, const AsciiGrid& grid, const AsciiGrid& reference) {
+    const int w = grid.getWidth();
+    const int h = grid.getHeight();
+    const size_t rawBytes = static_cast<size_t>(w) * h * 4;
+    if (reference.getWidth() != w || reference.getHeight() != h) {
+        return false;
+    }
+
+    std::vector<uint8_t> runs(4);
+    std::vector<uint8_t> cells[4];
+    uint32_t skip = 0;
+    for (int y = 0; y < h; ++y) {
+        const uint8_t* flags = grid.row(AsciiGrid::FLAGS, y);
+        int x = 0;
+        while (x < w) {
+            // 未变化的字符格只累计跳过数（可以跨行）
+            int runStart = x;
+            while (x < w && !(flags[x] & AsciiGrid::FLAG_CHANGED)) {
+                x++;
+            }
+            skip += static_cast<uint32_t>(x - runStart);
+            if (x == w) {
+                break;
+            }
+            runStart = x;
+            while (x < w && (flags[x] & AsciiGrid::FLAG_CHANGED)) {
+                x++;
+            }
+            appendVarint(runs, skip);
+            appendVarint(runs, static_cast<uint32_t>(x - runStart));
+            skip = 0;
+
+            const uint8_t* glyphs = grid.row(AsciiGrid::GLYPH, y);
+            cells[0].insert(cells[0].end(), glyphs + runStart, glyphs + x);
+            for (int plane = AsciiGrid::BLUE; plane <= AsciiGrid::RED; ++plane) {
+                const uint8_t* now = grid.row(static_cast<AsciiGrid::Plane>(plane), y);
+                const uint8_t* before = reference.row(static_cast<AsciiGrid::Plane>(plane), y);
+                for (int cx = runStart; cx < x; ++cx) {
+                    cells[plane].push_back(static_cast<uint8_t>(now[cx] - before[cx]));
+                }
+            }
+            if (runs.size() + cells[0].size() * 4 >= rawBytes) {
+                return false;
+            }
+        }
+    }
+    if (skip > 0) {
+        appendVarint(runs, skip);
+        appendVarint(runs, 0);
+    }
+
+    const uint32_t runBytes = static_cast<uint32_t>(runs.size() - 4);
+    for (int i = 0; i < 4; ++i) {
+        runs[i] = static_cast<uint8_t>((runBytes >> (8 * i)) & 0xFF);
+    }
+    for (const std::vector<uint8_t>& plane : cells) {
+        runs.insert(runs.end(), plane.begin(), plane.end());
+    }
+    appendDeflateRecord(out, GridFormat::FRAME_DELTA, runs);
+    return true;
+}
+
+/*
+ * 解码帧间预测帧数据函数（FRAME_DELTA解压后的数据，格式见 appendGridDelta）
+ * 返回值：数据损坏时返回false
+ */
+inline bool applyGridDelta(const uint8_t* body, size_t length, AsciiGrid& grid) {
+    const int w = grid.getWidth();
+    const uint32_t total = static_cast<uint32_t>(w) * grid.getHeight();
+    const uint32_t runBytes = length >= 4 ? loadLE(body, 4) : 0;
+    if (length < 4 || runBytes > length - 4 || (length - 4 - runBytes) % 4 != 0) {
+        return false;
+    }
+    const uint8_t* runs = body + 4;
+    const uint8_t* runsEnd = runs + runBytes;
+    const size_t changed = static_cast<size_t>(body + length - runsEnd) / 4;
+    const uint8_t* planes[4] = {runsEnd, runsEnd + changed, runsEnd + changed * 2, runsEnd + changed * 3};
+
+    uint32_t cell = 0;
+    size_t index = 0;
+    while (runs < runsEnd) {
+        uint32_t skip, count;
+        if (!loadVarint(runs, runsEnd, skip) || !loadVarint(runs, runsEnd, count) ||
+            skip > total - cell || count > total - cell - skip || count > changed - index) {
+            return false;
+        }
+        cell += skip;
+        for (uint32_t i = 0; i < count; ++i, ++cell, ++index) {
+            const int y = static_cast<int>(cell / w);
+            const int x = static_cast<int>(cell % w);
+            grid.row(AsciiGrid::GLYPH, y)[x] = planes[0][index];
+            grid.row(AsciiGrid::BLUE, y)[x] += planes[1][index];
+            grid.row(AsciiGrid::GREEN, y)[x] += planes[2][index];
+            grid.row(AsciiGrid::RED, y)[x] += planes[3][index];
+            grid.row(AsciiGrid::FLAGS, y)[x] = AsciiGrid::FLAG_CHANGED;
+        }
+    }
+    return index == changed;
+}
+
+/*
+ * 解码帧记录函数
+ * 直接解析内存中的帧记录（独立播放器在映射的文件上调用，不经过流），数据先解压到本线程的缓冲区；
+ * 预测帧在grid现有内容（上一帧）上覆盖变化的字符格，FLAGS平面标记本帧变化的字符格，
+ * 原始帧把全部字符格标记为变化
+ *
+ * 返回值：
+ *   size_t: 本帧记录的总字节数；数据不足、记录损坏或帧类型不支持时返回0
+ */
+inline size_t decodeGridFrame(const uint8_t* data, size_t size, const GridFileHeader& header, AsciiGrid& grid) {
+    if (size < 12 || loadLE(data, 4) != GridFormat::FRAME_MAGIC) {
+        return 0;
+    }
+    const uint32_t type = loadLE(data + 4, 4);
+    const uint32_t bytes = loadLE(data + 8, 4);
+    const int w = header.width;
+    const int h = header.height;
+    const size_t rawBytes = static_cast<size_t>(w) * h * 4;
+    if (bytes > size - 12 || bytes < 4 || (type != GridFormat::FRAME_RAW && type != GridFormat::FRAME_DELTA)) {
+        return 0;
+    }
+    const uint8_t* payload = data + 12;
+
+    // 解压后的预测帧数据比原始帧小（见 appendGridDelta），末尾最多再有一对变长整数
+    thread_local std::vector<uint8_t> body;
+    uLongf length = loadLE(payload, 4);
+    if (length > rawBytes + 16) {
+        return 0;
+    }
+    body.resize(length);
+    if (uncompress(body.data(), &length, payload + 4, bytes - 4) != Z_OK || length != body.size()) {
+        return 0;
+    }
+
+    if (type == GridFormat::FRAME_DELTA) {
+        // 预测帧需要尺寸一致的上一帧
+        if (grid.getWidth() != w || grid.getHeight() != h) {
+            return 0;
+        }
+        for (int y = 0; y < h; ++y) {
+            std::memset(grid.row(AsciiGrid::FLAGS, y), 0, w);
+        }
+        return applyGridDelta(body.data(), body.size(), grid) ? 12 + static_cast<size_t>(bytes) : 0;
+    }
+
+    if (body.size() != rawBytes) {
+        return 0;
+    }
+    grid.resize(w, h);
+    const uint8_t* planes = body.data();
+    for (int plane = AsciiGrid::GLYPH; plane <= AsciiGrid::RED; ++plane) {
+        for (int y = 0; y < h; ++y) {
+            std::memcpy(grid.row(static_cast<AsciiGrid::Plane>(plane), y), planes, w);
+            planes += w;
+        }
+    }
+    for (int y = 0; y < h; ++y) {
+        std::memset(grid.row(AsciiGrid::FLAGS, y), AsciiGrid::FLAG_CHANGED, w);
+    }
+    return 12 + static_cast<size_t>(bytes);
+}
+
+/*
+ * 读帧函数
+ * 从流中读出一条帧记录（原始帧或预测帧）并解码到grid，预测帧要求grid保存着上一帧
+ * 返回值：到达文件末尾、帧记录损坏或帧类型不支持时返回false
+ */
+inline bool readGridFrame(std::istream& in, const GridFileHeader& header, AsciiGrid& grid) {
+    std::vector<uint8_t> record(12);
+    if (!in.read(reinterpret_cast<char*>(record.data()), 12)) {
+        return false;
+    }
+    // 压缩后的帧记录不超过原始帧加zlib开销，超过上限的长度视为损坏
+    const uint32_t bytes = loadLE(record.data() + 8, 4);
+    if (bytes > static_cast<uint64_t>(header.width) * header.height * 5 + 64) {
+        return false;
+    }
+    record.resize(12 + static_cast<size_t>(bytes));
+    if (!in.read(reinterpret_cast<char*>(record.data() + 12), bytes)) {
+        return false;
+    }
+    return decodeGridFrame(record.data(), record.size(), header, grid) != 0;
+}
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ * 网格文件格式往返检查
+ * 用随机生成的网格和图集写出一个 .mgrid 到内存，再按转换器和播放器的读法读回，
+ * 逐平面比较；只依赖 miku_grid.h 和 zlib，不需要 OpenCV
+ *
+ * 编译: g++ -O2 -std=c++17 -Wall -Wextra -o miku_grid_test miku_grid_test.cpp -lz
+ * 运行: ./miku_grid_test   （全部通过返回0，否则输出第一处不一致并返回1）
+ *
+ * 作者: miku-01-hein + GPT
+ */
+
+#include "miku_grid.h"
+
+#include <cstdint>               // 定宽整数类型
+#include <iostream>              // 结果输出
+#include <random>                // 随机网格
+#include <sstream>               // 内存中的网格文件
+#include <string>                // 字符串处理
+#include <vector>                // 字节缓冲区
+
+namespace TestConstants {
+    constexpr int GRID_WIDTH = 120;     // 网格列数（不是64的倍数，覆盖行填充）
+    constexpr int GRID_HEIGHT = 56;     // 网格行数
+    constexpr int FRAME_COUNT = 48;     // 帧数
+    constexpr int KEYFRAME_INTERVAL = 16;  // 每隔多少帧强制写原始帧
+    constexpr uint32_t SEED = 39;       // 随机种子，结果可复现
+}
+
+/*
+ * 比较两个网格的字形和颜色平面
+ * 返回值：完全相同返回true，否则输出第一处不同的位置
+ */
+bool sameGrid(const AsciiGrid& expected, const AsciiGrid& actual, int frame) {
+    if (expected.getWidth() != actual.getWidth() || expected.getHeight() != actual.getHeight()) {
+        std::cerr << "第 " << frame << " 帧尺寸不符" << std::endl;
+        return false;
+    }
+    for (int plane = AsciiGrid::GLYPH; plane <= AsciiGrid::RED; ++plane) {
+        for (int y = 0; y < expected.getHeight(); ++y) {
+            const uint8_t* a = expected.row(static_cast<AsciiGrid::Plane>(plane), y);
+            const uint8_t* b = actual.row(static_cast<AsciiGrid::Plane>(plane), y);
+            for (int x = 0; x < expected.getWidth(); ++x) {
+                if (a[x] != b[x]) {
+                    std::cerr << "第 " << frame << " 帧平面 " << plane << " (" << x << ", " << y << ") 不符: "
+                              << static_cast<int>(a[x]) << " != " << static_cast<int>(b[x]) << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * 生成下一帧：随机改变一部分字符格，changeRate为0到1之间的比例；
+ * 颜色变化有大有小，覆盖残差的正负和回绕
+ */
+void mutateGrid(AsciiGrid& grid, std::mt19937& rng, double changeRate, int glyphCount) {
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::uniform_int_distribution<int> glyph(0, glyphCount - 1);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> nudge(-6, 6);
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        for (int x = 0; x < grid.getWidth(); ++x) {
+            if (chance(rng) >= changeRate) {
+                continue;
+            }
+            grid.row(AsciiGrid::GLYPH, y)[x] = static_cast<uint8_t>(glyph(rng));
+            const bool small = chance(rng) < 0.7;
+            for (int plane = AsciiGrid::BLUE; plane <= AsciiGrid::RED; ++plane) {
+                uint8_t& value = grid.row(static_cast<AsciiGrid::Plane>(plane), y)[x];
+                value = small ? static_cast<uint8_t>(value + nudge(rng)) : static_cast<uint8_t>(byte(rng));
+            }
+        }
+    }
+}
+
+int main() {
+    using namespace TestConstants;
+    std::mt19937 rng(SEED);
+
+    // 文件头：自定义字符集和随机图集
+    GridFileHeader header;
+    header.width = GRID_WIDTH;
+    header.height = GRID_HEIGHT;
+    header.cellWidth = 6;
+    header.cellHeight = 12;
+    header.fpsMilli = 29970;
+    header.mono = 0;
+    header.modes = GridFormat::MODE_BACKGROUND_FILL | GridFormat::MODE_COVERAGE_COMPENSATION;
+    header.charset = " .:-=+*#%@";
+    header.tileWidth = 8;
+    header.glyphAlpha.resize(header.charset.size() * header.tileWidth * header.cellHeight);
+    for (uint8_t& alpha : header.glyphAlpha) {
+        alpha = static_cast<uint8_t>(rng() & 0xFF);
+    }
+    const int glyphCount = static_cast<int>(header.charset.size());
+
+    // 写出：与转换器相同，先与上一帧比较，能用预测帧时写预测帧，否则写原始帧
+    std::vector<AsciiGrid> frames(FRAME_COUNT);
+    std::ostringstream file(std::ios::binary);
+    if (!writeGridHeader(file, header)) {
+        std::cerr << "写文件头失败" << std::endl;
+        return 1;
+    }
+    AsciiGrid reference;
+    int deltaFrames = 0;
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        AsciiGrid& grid = frames[i];
+        if (i == 0) {
+            grid.resize(GRID_WIDTH, GRID_HEIGHT);
+            mutateGrid(grid, rng, 1.0, glyphCount);
+        } else {
+            grid.copyFrom(frames[i - 1]);
+            // 大部分帧少量变化，偶尔整帧变化（预测帧不划算，应改写原始帧）
+            mutateGrid(grid, rng, i % 11 == 0 ? 1.0 : 0.05, glyphCount);
+        }
+        grid.markChanges(reference);
+        std::vector<uint8_t> record;
+        if (i % KEYFRAME_INTERVAL != 0 && appendGridDelta(record, grid, reference)) {
+            ++deltaFrames;
+        } else {
+            appendGridFrame(record, grid);
+        }
+        file.write(reinterpret_cast<const char*>(record.data()), static_cast<std::streamsize>(record.size()));
+        reference.copyFrom(grid);
+    }
+    if (deltaFrames == 0 || deltaFrames == FRAME_COUNT - 1) {
+        std::cerr << "预测帧数量异常: " << deltaFrames << std::endl;
+        return 1;
+    }
+
+    // 读回文件头
+    const std::string bytes = file.str();
+    std::istringstream in(bytes, std::ios::binary);
+    GridFileHeader loaded;
+    if (!readGridHeader(in, loaded)) {
+        std::cerr << "读文件头失败" << std::endl;
+        return 1;
+    }
+    if (loaded.width != header.width || loaded.height != header.height || loaded.cellWidth != header.cellWidth ||
+        loaded.cellHeight != header.cellHeight || loaded.fpsMilli != header.fpsMilli || loaded.mono != header.mono ||
+        loaded.modes != header.modes || loaded.charset != header.charset || loaded.tileWidth != header.tileWidth ||
+        loaded.glyphAlpha != header.glyphAlpha) {
+        std::cerr << "文件头字段不符" << std::endl;
+        return 1;
+    }
+
+    // 流式读帧（转换器 --decode-grid 的读法）
+    AsciiGrid decoded;
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        if (!readGridFrame(in, loaded, decoded)) {
+            std::cerr << "第 " << i << " 帧读取失败" << std::endl;
+            return 1;
+        }
+        if (!sameGrid(frames[i], decoded, i)) {
+            return 1;
+        }
+    }
+    if (readGridFrame(in, loaded, decoded)) {
+        std::cerr << "文件末尾多出帧记录" << std::endl;
+        return 1;
+    }
+
+    // 内存中逐条解码（播放器的读法），同时检查FLAGS平面标记的变化字符格
+    std::istringstream again(bytes, std::ios::binary);
+    readGridHeader(again, loaded);
+    size_t offset = static_cast<size_t>(again.tellg());
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    AsciiGrid mapped;
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        const size_t used = decodeGridFrame(data + offset, bytes.size() - offset, loaded, mapped);
+        if (used == 0) {
+            std::cerr << "第 " << i << " 帧解码失败" << std::endl;
+            return 1;
+        }
+        offset += used;
+        if (!sameGrid(frames[i], mapped, i)) {
+            return 1;
+        }
+        for (int y = 0; y < GRID_HEIGHT && i > 0; ++y) {
+            for (int x = 0; x < GRID_WIDTH; ++x) {
+                const bool changed = mapped.row(AsciiGrid::FLAGS, y)[x] & AsciiGrid::FLAG_CHANGED;
+                bool differs = false;
+                for (int plane = AsciiGrid::GLYPH; plane <= AsciiGrid::RED; ++plane) {
+                    const auto p = static_cast<AsciiGrid::Plane>(plane);
+                    differs |= frames[i].row(p, y)[x] != frames[i - 1].row(p, y)[x];
+                }
+                // 原始帧把全部字符格标记为变化，预测帧只标记变化的字符格
+                if (differs && !changed) {
+                    std::cerr << "第 " << i << " 帧 (" << x << ", " << y << ") 变化但没有标记" << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+    if (offset != bytes.size()) {
+        std::cerr << "帧记录总长度不符" << std::endl;
+        return 1;
+    }
+
+    // 损坏的文件应被拒绝：改动格式版本、截断图集、截断帧记录
+    std::string badVersion = bytes;
+    badVersion[4] = static_cast<char>(GridFormat::FILE_VERSION + 1);
+    std::istringstream badVersionIn(badVersion, std::ios::binary);
+    std::istringstream truncatedHeader(bytes.substr(0, offset > 64 ? 64 : offset / 2), std::ios::binary);
+    GridFileHeader rejected;
+    if (readGridHeader(badVersionIn, rejected) || readGridHeader(truncatedHeader, rejected)) {
+        std::cerr << "损坏的文件头没有被拒绝" << std::endl;
+        return 1;
+    }
+    std::istringstream truncatedFrame(bytes.substr(0, bytes.size() - 3), std::ios::binary);
+    readGridHeader(truncatedFrame, rejected);
+    AsciiGrid partial;
+    int readable = 0;
+    while (readGridFrame(truncatedFrame, rejected, partial)) {
+        ++readable;
+    }
+    if (readable != FRAME_COUNT - 1) {
+        std::cerr << "截断的帧记录没有被拒绝" << std::endl;
+        return 1;
+    }
+
+    std::cout << "网格文件往返检查通过: " << FRAME_COUNT << " 帧（预测帧 " << deltaFrames << "），"
+              << bytes.size() << " 字节" << std::endl;
+    return 0;
+}
@@ -0,0 +1,776 @@
+/*
+ * 字符网格播放器
+ * 直接播放 ./miku --grid-out 写出的字符网格文件（.mgrid），不需要OpenCV和视频编码，只需要zlib
+ * 编译命令：g++ -O3 -march=native -std=c++17 -o miku_player miku_player.cpp -lz
+ * 使用示例：./miku_player ascii.mgrid
+ *
+ * 作者: miku-01-hein + GPT
+ *
+ * 工作原理：
+ * 1. 把网格文件整个映射到内存，帧记录直接在映射上解码（miku_grid.h 的 decodeGridFrame）
+ * 2. 预测帧只更新变化的字符格，播放时也只重画这些字符格：
+ *    终端模式输出变化字符格的真彩色字符，像素模式用文件头中保存的字形图集贴图到无窗口的像素缓冲区
+ * 3. 按文件头的帧率定时播放；来不及时跳过输出，变化累积到下一次输出
+ * 4. 文件头记录的渲染模式（背景填充、覆盖率补偿）与 ./miku --decode-grid 的绘制方式相同
+ *
+ * 运行模式：
+ *   默认        在终端中播放（ANSI真彩色），按 Ctrl+C 退出；终端窗口放不下网格时不播放，
+ *               以退出码2退出（start.sh 据此改用mpv播放），--crop 时只播放窗口放得下的中间部分
+ *   --raw OUT   把每帧渲染成原始像素（彩色bgr24、灰度gray）写到文件，OUT为 - 时写到标准输出，
+ *               例如：./miku_player ascii.mgrid --raw - | ffplay -f rawvideo -pixel_format bgr24 -video_size 900x540 -
+ *   --bench     不输出，尽快解码并渲染到像素缓冲区，报告解码、渲染和合计帧率
+ */
+
+#include <iostream>              // 输入输出流
+#include <fstream>               // 读取网格文件头
+#include <vector>                // 向量容器
+#include <string>                // 字符串处理
+#include <algorithm>             // 算法函数（如min、max等）
+#include <cmath>                 // 覆盖率补偿增益取整
+#include <chrono>                // 播放定时、基准测试计时
+#include <thread>                // 等待到帧的显示时刻
+#include <atomic>                // 中断标志
+#include <memory>                // 终端渲染器
+#include <csignal>               // Ctrl+C 处理
+#include <cstdint>               // 定宽整数类型
+#include <cstdio>                // 原始像素输出
+#include <cstdlib>               // 数值解析
+#include <cstring>               // 内存清零
+#include <fcntl.h>               // 打开网格文件
+#include <sys/ioctl.h>           // 终端窗口大小
+#include <sys/mman.h>            // 文件映射
+#include <sys/stat.h>            // 文件大小
+#include <unistd.h>              // 终端写出、关闭文件
+
+#include "miku_grid.h"          // 结构数组字符网格和网格文件格式
+
+/*
+ * 播放器常量
+ * 与转换器（miku.cpp 的 ASCIIVideoConstants）保持一致
+ */
+namespace PlayerConstants {
+    // 半角字符格的像素宽度（ASCIIVideoConstants::ASCII_CHAR_WIDTH），全角字符集的字符格为它的两倍
+    constexpr int CELL_WIDTH = 6;
+
+    // 亮度权重（Q8定点），灰度文件在终端中的字符颜色
+    constexpr int RED_WEIGHT_Q8 = 77;
+    constexpr int GREEN_WEIGHT_Q8 = 150;
+    constexpr int BLUE_WEIGHT_Q8 = 256 - RED_WEIGHT_Q8 - GREEN_WEIGHT_Q8;
+
+    // 背景填充模式中字符与背景的对比度（0-255）
+    constexpr int BACKGROUND_GLYPH_CONTRAST = 160;
+
+    // 覆盖率补偿的最大增益
+    constexpr double COVERAGE_MAX_GAIN = 4.0;
+
+    // 文件头没有帧率时的默认帧率
+    constexpr double DEFAULT_FPS = 25.0;
+
+    // 终端输出缓冲区的初始容量（字节），一帧的转义序列一次写出
+    constexpr size_t TERMINAL_BUFFER_BYTES = 1 << 20;
+
+    // 终端窗口放不下网格时的退出码
+    constexpr int EXIT_TERMINAL_TOO_SMALL = 2;
+}
+
+// Ctrl+C 时置位，播放循环在帧之间检查
+static std::atomic<bool> stopRequested(false);
+
+static void handleInterrupt(int) {
+    stopRequested = true;
+}
+
+/*
+ * MappedFile类
+ * 只读映射整个文件，析构时解除映射；顺序访问提示让内核提前读入后面的帧
+ */
+class MappedFile {
+private:
+    const uint8_t* data;
+    size_t size;
+
+public:
+    MappedFile() : data(nullptr), size(0) {}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (data) {
+            munmap(const_cast<uint8_t*>(data), size);
+        }
+    }
+
+    bool open(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        madvise(mapped, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        data = static_cast<const uint8_t*>(mapped);
+        size = static_cast<size_t>(st.st_size);
+        return true;
+    }
+
+    const uint8_t* bytes() const { return data; }
+    size_t length() const { return size; }
+};
+
+/*
+ * 字符集拆分函数
+ * 把UTF-8字符集拆成每个字形一段文本（终端模式直接输出），编码无效时返回false
+ */
+static bool splitCharset(const std::string& charset, std::vector<std::string>& glyphs) {
+    glyphs.clear();
+    for (size_t i = 0; i < charset.size();) {
+        unsigned char lead = static_cast<unsigned char>(charset[i]);
+        size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        if (length == 0 || i + length > charset.size()) {
+            return false;
+        }
+        glyphs.push_back(charset.substr(i, length));
+        i += length;
+    }
+    return true;
+}
+
+// 字符格亮度（与转换器的 computeLuma 相同）
+static inline uint8_t cellLuma(uint8_t blue, uint8_t green, uint8_t red) {
+    return static_cast<uint8_t>((PlayerConstants::RED_WEIGHT_Q8 * red + PlayerConstants::GREEN_WEIGHT_Q8 * green +
+                                 PlayerConstants::BLUE_WEIGHT_Q8 * blue + 128) >> 8);
+}
+
+/*
+ * 背景填充模式的字符颜色（与转换器的 generateBackgroundFillFrame 相同）：
+ * 亮背景上是变暗的字符，暗背景上是提亮的字符
+ */
+static inline uint8_t contrastLevel(uint8_t background, bool bright) {
+    const int contrast = PlayerConstants::BACKGROUND_GLYPH_CONTRAST;
+    return static_cast<uint8_t>(bright ? background * (255 - contrast) / 255
+                                       : background + (255 - background) * contrast / 255);
+}
+
+// 按字形增益（Q8）缩放颜色分量，饱和到255
+static inline uint8_t applyGain(uint8_t value, int gain) {
+    return static_cast<uint8_t>(std::min(255, (value * gain) >> 8));
+}
+
+/*
+ * 字形图块
+ * 按网格字形编号排列的透明度图块，每块 tileWidth x tileHeight，比字符格左右各宽 padding 像素
+ */
+struct GlyphTiles {
+    int tileWidth = 0;
+    int tileHeight = 0;
+    int padding = 0;
+    std::vector<uint8_t> alpha;
+    std::vector<int> columnBegin;  // 每个字形第一个非空列（空白字符为tileWidth）
+    std::vector<int> columnEnd;    // 每个字形最后一个非空列之后
+};
+
+/*
+ * 读取字形图块函数
+ * 文件头带有转换时绘制的图集，任意字符集和 --font 字体都按原样使用
+ *
+ * 返回值：
+ *   bool: 图集与字符集或字形尺寸不符时返回false
+ */
+static bool loadGlyphTiles(const GridFileHeader& header, const std::vector<std::string>& glyphs, GlyphTiles& tiles) {
+    tiles.tileWidth = header.tileWidth;
+    tiles.tileHeight = header.cellHeight;
+    tiles.padding = (header.tileWidth - header.cellWidth) / 2;
+    if (header.tileWidth < header.cellWidth || tiles.padding > header.cellWidth ||
+        header.glyphAlpha.size() != glyphs.size() * header.tileWidth * header.cellHeight) {
+        std::cerr << "错误: 字符网格文件中的字形图集与字符集不符" << std::endl;
+        return false;
+    }
+    tiles.alpha = header.glyphAlpha;
+
+    // 每个字形的非空列范围，绘制时跳过空列
+    const size_t tileBytes = static_cast<size_t>(tiles.tileWidth) * tiles.tileHeight;
+    tiles.columnBegin.assign(256, tiles.tileWidth);
+    tiles.columnEnd.assign(256, 0);
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        const uint8_t* tile = tiles.alpha.data() + i * tileBytes;
+        for (int y = 0; y < tiles.tileHeight; ++y) {
+            for (int x = 0; x < tiles.tileWidth; ++x) {
+                if (tile[y * tiles.tileWidth + x]) {
+                    tiles.columnBegin[i] = std::min(tiles.columnBegin[i], x);
+                    tiles.columnEnd[i] = std::max(tiles.columnEnd[i], x + 1);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * 覆盖率补偿增益表函数（与转换器的 rebuildGlyphGains 相同）
+ * 每个字形的增益 = 最高覆盖率 / 本字形覆盖率，限制在 [1, COVERAGE_MAX_GAIN]，Q8定点
+ */
+static std::vector<int> glyphGains(const GlyphTiles& tiles, int cellWidth) {
+    const size_t tileBytes = static_cast<size_t>(tiles.tileWidth) * tiles.tileHeight;
+    const size_t count = tileBytes > 0 ? tiles.alpha.size() / tileBytes : 0;
+    std::vector<double> coverage(count, 0.0);
+    double maxCoverage = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        long sum = 0;
+        for (size_t k = 0; k < tileBytes; ++k) {
+            sum += tiles.alpha[i * tileBytes + k];
+        }
+        coverage[i] = static_cast<double>(sum) / (255.0 * cellWidth * tiles.tileHeight);
+        maxCoverage = std::max(maxCoverage, coverage[i]);
+    }
+    std::vector<int> gains(256, 256);
+    for (size_t i = 0; i < count; ++i) {
+        if (coverage[i] > 0.0) {
+            double gain = std::clamp(maxCoverage / coverage[i], 1.0, PlayerConstants::COVERAGE_MAX_GAIN);
+            gains[i] = static_cast<int>(std::lround(gain * 256.0));
+        }
+    }
+    return gains;
+}
+
+/*
+ * PixelRenderer类
+ * 用文件头中保存的字形图块把字符网格渲染到无窗口的像素缓冲区，
+ * 绘制方式与转换器的 blitColor / blitMono 相同：
+ * 输出 = max(原值, 透明度 * 颜色 / 255)，彩色为BGR三通道，灰度文件为单通道
+ *
+ * 增量重画：
+ *   字形图块比字符格左右各宽 padding（不超过一个字符格）像素，笔画会伸入相邻字符格，
+ *   所以变化字符格及其左右相邻格（需重画格）先清成黑色，再绘制距离变化格两格以内的全部字形；
+ *   未清除的字符格上重复绘制同样的字形结果不变（取最大值），输出与整帧重画完全一致；
+ *   背景填充模式的字符按透明度混合到背景上，重复绘制会叠加，有变化的字符行整行重画
+ */
+class PixelRenderer {
+private:
+    int columns;                 // 网格列数
+    int rows;                    // 网格行数
+    int cellWidth;               // 字符格像素宽度
+    int cellHeight;              // 字符格像素高度
+    int channels;                // 1 = 灰度，3 = BGR
+    GlyphTiles tiles;            // 按网格字形编号排列的图块
+    std::vector<uint8_t> pixels; // 像素缓冲区（行间无填充）
+    std::vector<uint8_t> repaint;  // 本行需重画的字符格
+    bool backgroundFill;         // 背景填充模式
+    bool backgroundGlyphs;       // 背景填充模式下叠加对比色字符
+    std::vector<int> gains;      // 覆盖率补偿增益（Q8，未启用时全为256）
+
+    static inline uint8_t scale(int a, int v) {
+        int product = a * v + 128;
+        return static_cast<uint8_t>((product + (product >> 8)) >> 8);
+    }
+
+public:
+    PixelRenderer()
+        : columns(0), rows(0), cellWidth(0), cellHeight(0), channels(3),
+          backgroundFill(false), backgroundGlyphs(false) {}
+
+    /*
+     * 初始化函数
+     * 参数：
+     *   glyphTiles: loadGlyphTiles 读出的图块
+     *   glyphGain: 覆盖率补偿增益（未启用时全为256）
+     */
+    void init(const GridFileHeader& header, const GlyphTiles& glyphTiles, const std::vector<int>& glyphGain) {
+        tiles = glyphTiles;
+        gains = glyphGain;
+        columns = header.width;
+        rows = header.height;
+        cellWidth = header.cellWidth;
+        cellHeight = header.cellHeight;
+        channels = header.mono ? 1 : 3;
+        backgroundFill = (header.modes & GridFormat::MODE_BACKGROUND_FILL) != 0;
+        backgroundGlyphs = (header.modes & GridFormat::MODE_BACKGROUND_GLYPHS) != 0;
+        pixels.assign(static_cast<size_t>(frameWidth()) * frameHeight() * channels, 0);
+        repaint.assign(columns, 0);
+    }
+
+    int frameWidth() const { return columns * cellWidth; }
+    int frameHeight() const { return rows * cellHeight; }
+    int pixelChannels() const { return channels; }
+    const std::vector<uint8_t>& frame() const { return pixels; }
+
+    /*
+     * 渲染函数
+     * 按FLAGS平面只重画变化的字符格（原始帧的全部字符格都标记为变化）
+     */
+    void render(const AsciiGrid& grid) {
+        const size_t rowBytes = static_cast<size_t>(frameWidth()) * channels;
+        for (int y = 0; y < rows; ++y) {
+            const uint8_t* flags = grid.row(AsciiGrid::FLAGS, y);
+            bool any = false;
+            for (int x = 0; x < columns; ++x) {
+                repaint[x] = static_cast<uint8_t>(((x > 0 ? flags[x - 1] : 0) | flags[x] |
+                                                   (x + 1 < columns ? flags[x + 1] : 0)) & AsciiGrid::FLAG_CHANGED);
+                any |= repaint[x] != 0;
+            }
+            if (!any) {
+                continue;
+            }
+            if (backgroundFill) {
+                renderFilledRow(grid, y);
+                continue;
+            }
+
+            // 清除需重画的字符格
+            uint8_t* band = pixels.data() + static_cast<size_t>(y) * cellHeight * rowBytes;
+            const size_t cellBytes = static_cast<size_t>(cellWidth) * channels;
+            for (int x = 0; x < columns; ++x) {
+                if (repaint[x]) {
+                    for (int py = 0; py < cellHeight; ++py) {
+                        std::memset(band + py * rowBytes + x * cellBytes, 0, cellBytes);
+                    }
+                }
+            }
+
+            // 重新绘制需重画格及其左右相邻格上的字形
+            const uint8_t* glyphs = grid.row(AsciiGrid::GLYPH, y);
+            const uint8_t* blue = grid.row(AsciiGrid::BLUE, y);
+            const uint8_t* green = grid.row(AsciiGrid::GREEN, y);
+            const uint8_t* red = grid.row(AsciiGrid::RED, y);
+            for (int x = 0; x < columns; ++x) {
+                if (!repaint[x] && !(x > 0 && repaint[x - 1]) && !(x + 1 < columns && repaint[x + 1])) {
+                    continue;
+                }
+                blit(band, rowBytes, x, glyphs[x], blue[x], green[x], red[x]);
+            }
+        }
+    }
+
+private:
+    /*
+     * 背景填充模式的整行绘制（与转换器的 generateBackgroundFillFrame 相同）：
+     * 先把整个字符行填满各格颜色，再从左到右把对比色字符混合上去，
+     * 伸出字符格的笔画混合在相邻背景上
+     */
+    void renderFilledRow(const AsciiGrid& grid, int y) {
+        const size_t rowBytes = static_cast<size_t>(frameWidth()) * channels;
+        uint8_t* band = pixels.data() + static_cast<size_t>(y) * cellHeight * rowBytes;
+        const uint8_t* glyphs = grid.row(AsciiGrid::GLYPH, y);
+        const uint8_t* blue = grid.row(AsciiGrid::BLUE, y);
+        const uint8_t* green = grid.row(AsciiGrid::GREEN, y);
+        const uint8_t* red = grid.row(AsciiGrid::RED, y);
+        for (int x = 0; x < columns; ++x) {
+            for (int i = 0; i < cellWidth; ++i) {
+                uint8_t* out = band + (static_cast<size_t>(x) * cellWidth + i) * 3;
+                out[0] = blue[x];
+                out[1] = green[x];
+                out[2] = red[x];
+            }
+        }
+        for (int py = 1; py < cellHeight; ++py) {
+            std::memcpy(band + py * rowBytes, band, rowBytes);
+        }
+        if (!backgroundGlyphs) {
+            return;
+        }
+
+        for (int x = 0; x < columns; ++x) {
+            const bool bright = cellLuma(blue[x], green[x], red[x]) >= 128;
+            const uint8_t color[3] = {contrastLevel(blue[x], bright), contrastLevel(green[x], bright),
+                                      contrastLevel(red[x], bright)};
+            const int glyph = glyphs[x];
+            const int originX = x * cellWidth - tiles.padding;
+            const int x0 = std::max(tiles.columnBegin[glyph], -originX);
+            const int x1 = std::min(tiles.columnEnd[glyph], frameWidth() - originX);
+            const uint8_t* alpha = tiles.alpha.data() + static_cast<size_t>(glyph) * tiles.tileWidth * cellHeight;
+            for (int py = 0; py < cellHeight; ++py) {
+                const uint8_t* src = alpha + py * tiles.tileWidth;
+                uint8_t* dst = band + py * rowBytes;
+                for (int px = x0; px < x1; ++px) {
+                    int a = src[px];
+                    uint8_t* out = dst + (originX + px) * 3;
+                    for (int ch = 0; ch < 3; ++ch) {
+                        out[ch] = static_cast<uint8_t>(scale(255 - a, out[ch]) + scale(a, color[ch]));
+                    }
+                }
+            }
+        }
+    }
+
+    // 把第glyph个字形绘制到字符行band的第cellX格，裁剪到帧宽度之内；颜色按覆盖率补偿增益缩放
+    void blit(uint8_t* band, size_t rowBytes, int cellX, int glyph, uint8_t blue, uint8_t green, uint8_t red) {
+        const int originX = cellX * cellWidth - tiles.padding;
+        const int x0 = std::max(tiles.columnBegin[glyph], -originX);
+        const int x1 = std::min(tiles.columnEnd[glyph], frameWidth() - originX);
+        if (x0 >= x1) {
+            return;
+        }
+        const uint8_t* alpha = tiles.alpha.data() + static_cast<size_t>(glyph) * tiles.tileWidth * cellHeight;
+        const int gain = gains[glyph];
+        const uint8_t level = applyGain(cellLuma(blue, green, red), gain);
+        blue = applyGain(blue, gain);
+        green = applyGain(green, gain);
+        red = applyGain(red, gain);
+
+        for (int py = 0; py < cellHeight; ++py) {
+            const uint8_t* src = alpha + py * tiles.tileWidth;
+            uint8_t* dst = band + py * rowBytes;
+            if (channels == 1) {
+                for (int x = x0; x < x1; ++x) {
+                    uint8_t& out = dst[originX + x];
+                    out = std::max(out, scale(src[x], level));
+                }
+                continue;
+            }
+            for (int x = x0; x < x1; ++x) {
+                int a = src[x];
+                uint8_t* out = dst + (originX + x) * 3;
+                out[0] = std::max(out[0], scale(a, blue));
+                out[1] = std::max(out[1], scale(a, green));
+                out[2] = std::max(out[2], scale(a, red));
+            }
+        }
+    }
+};
+
+/*
+ * TerminalRenderer类
+ * 在终端中用真彩色字符播放：字符格就是终端的一个（全角字符集为两个）字符位置，
+ * 终端自己的字体代替字形图集；每次输出只移动光标到变化的字符格并改写，
+ * 跳过输出的帧的变化累积在pending中，下一次输出一并改写；
+ * 背景填充模式设置字符位置的背景色，字符用对比色；
+ * 只输出视口（viewX, viewY 起的 viewColumns x viewRows 个字符格），--crop 时视口小于网格
+ */
+class TerminalRenderer {
+private:
+    int columns;
+    int rows;
+    int span;                    // 每个字符格占的终端列数
+    int viewX;                   // 视口左上角的字符格
+    int viewY;
+    int viewColumns;             // 视口大小（字符格）
+    int viewRows;
+    bool mono;
+    bool backgroundFill;
+    bool backgroundGlyphs;
+    std::vector<int> gains;        // 覆盖率补偿增益（Q8）
+    std::vector<std::string> glyphText;
+    std::vector<uint8_t> pending;  // 尚未输出的变化字符格
+    std::string buffer;            // 本次输出的转义序列
+
+    // 写出全部字节（终端写入可能只完成一部分）
+    static void writeAll(const std::string& text) {
+        size_t done = 0;
+        while (done < text.size()) {
+            ssize_t written = ::write(STDOUT_FILENO, text.data() + done, text.size() - done);
+            if (written <= 0) {
+                return;
+            }
+            done += static_cast<size_t>(written);
+        }
+    }
+
+    // 追加设置真彩色的转义序列（layer为38前景、48背景）
+    void appendColor(int layer, int color) {
+        buffer += "\x1b[" + std::to_string(layer) + ";2;" + std::to_string((color >> 16) & 0xFF) + ";" +
+                  std::to_string((color >> 8) & 0xFF) + ";" + std::to_string(color & 0xFF) + "m";
+    }
+
+public:
+    TerminalRenderer(const GridFileHeader& header, const std::vector<std::string>& glyphs, const std::vector<int>& glyphGain,
+                     int windowColumns, int windowRows)
+        : columns(header.width), rows(header.height), span(cellSpan(header)),
+          viewColumns(std::min<int>(header.width, windowColumns / span)), viewRows(std::min<int>(header.height, windowRows)),
+          mono(header.mono != 0),
+          backgroundFill((header.modes & GridFormat::MODE_BACKGROUND_FILL) != 0),
+          backgroundGlyphs((header.modes & GridFormat::MODE_BACKGROUND_GLYPHS) != 0),
+          gains(glyphGain),
+          glyphText(glyphs),
+          pending(static_cast<size_t>(header.width) * header.height, 0) {
+        viewX = (columns - viewColumns) / 2;
+        viewY = (rows - viewRows) / 2;
+        glyphText.resize(256, " ");
+        buffer.reserve(PlayerConstants::TERMINAL_BUFFER_BYTES);
+        // 切换到备用屏幕、隐藏光标并清屏
+        writeAll("\x1b[?1049h\x1b[?25l\x1b[2J");
+    }
+
+    // 每个字符格占的终端列数（全角字符集为2）
+    static int cellSpan(const GridFileHeader& header) {
+        return std::max(1, header.cellWidth / PlayerConstants::CELL_WIDTH);
+    }
+
+    ~TerminalRenderer() {
+        writeAll("\x1b[0m\x1b[?25h\x1b[?1049l");
+    }
+
+    // 记录本帧变化的字符格（跳过输出的帧也要调用）
+    void accumulate(const AsciiGrid& grid) {
+        for (int y = 0; y < rows; ++y) {
+            const uint8_t* flags = grid.row(AsciiGrid::FLAGS, y);
+            uint8_t* mark = &pending[static_cast<size_t>(y) * columns];
+            for (int x = 0; x < columns; ++x) {
+                mark[x] |= flags[x] & AsciiGrid::FLAG_CHANGED;
+            }
+        }
+    }
+
+    // 输出累积的全部变化字符格；相邻字符格不重复移动光标，颜色相同不重复设置
+    void present(const AsciiGrid& grid) {
+        buffer.clear();
+        int64_t lastColor = -1;
+        for (int y = viewY; y < viewY + viewRows; ++y) {
+            uint8_t* mark = &pending[static_cast<size_t>(y) * columns];
+            const uint8_t* glyphs = grid.row(AsciiGrid::GLYPH, y);
+            const uint8_t* blue = grid.row(AsciiGrid::BLUE, y);
+            const uint8_t* green = grid.row(AsciiGrid::GREEN, y);
+            const uint8_t* red = grid.row(AsciiGrid::RED, y);
+            int cursor = -1;
+            for (int x = viewX; x < viewX + viewColumns; ++x) {
+                if (!mark[x]) {
+                    continue;
+                }
+                mark[x] = 0;
+                if (cursor != x) {
+                    buffer += "\x1b[" + std::to_string(y - viewY + 1) + ";" + std::to_string((x - viewX) * span + 1) + "H";
+                }
+                if (backgroundFill) {
+                    // 背景色为字符格颜色，前景为对比色
+                    const bool bright = cellLuma(blue[x], green[x], red[x]) >= 128;
+                    const int background = (red[x] << 16) | (green[x] << 8) | blue[x];
+                    const int foreground = (contrastLevel(red[x], bright) << 16) |
+                                           (contrastLevel(green[x], bright) << 8) | contrastLevel(blue[x], bright);
+                    const int64_t color = (static_cast<int64_t>(background) << 24) | foreground;
+                    if (color != lastColor) {
+                        appendColor(48, background);
+                        appendColor(38, foreground);
+                        lastColor = color;
+                    }
+                    buffer += backgroundGlyphs ? glyphText[glyphs[x]] : std::string(span, ' ');
+                    cursor = x + 1;
+                    continue;
+                }
+                const int gain = gains[glyphs[x]];
+                int r = applyGain(red[x], gain), g = applyGain(green[x], gain), b = applyGain(blue[x], gain);
+                if (mono) {
+                    r = g = b = applyGain(cellLuma(blue[x], green[x], red[x]), gain);
+                }
+                const int color = (r << 16) | (g << 8) | b;
+                if (color != lastColor) {
+                    appendColor(38, color);
+                    lastColor = color;
+                }
+                buffer += glyphText[glyphs[x]];
+                cursor = x + 1;
+            }
+        }
+        writeAll(buffer);
+    }
+};
+
+/*
+ * 打印用法函数
+ */
+static void printUsage(const char* program) {
+    std::cout << "用法: " << program << " <网格文件> [选项]" << std::endl;
+    std::cout << "  (默认)          在终端中播放，Ctrl+C 退出" << std::endl;
+    std::cout << "  --raw OUT       输出原始像素帧（彩色bgr24、灰度gray），OUT为 - 时写到标准输出" << std::endl;
+    std::cout << "  --bench         解码并渲染全部帧，报告帧率" << std::endl;
+    std::cout << "  --fps N         覆盖文件头中的播放帧率（0为不限速）" << std::endl;
+    std::cout << "  --loop          循环播放" << std::endl;
+    std::cout << "  --crop          终端窗口放不下网格时只播放中间部分（默认以退出码2退出）" << std::endl;
+}
+
+/*
+ * 主函数
+ */
+int main(int argc, char* argv[]) {
+    // 步骤1：解析命令行参数
+    std::string gridPath;
+    std::string rawPath;
+    bool bench = false;
+    bool loop = false;
+    bool crop = false;
+    double fpsOverride = -1.0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--raw" && hasValue) {
+            rawPath = argv[++i];
+        } else if (arg == "--bench") {
+            bench = true;
+        } else if (arg == "--loop") {
+            loop = true;
+        } else if (arg == "--crop") {
+            crop = true;
+        } else if (arg == "--fps" && hasValue) {
+            fpsOverride = std::atof(argv[++i]);
+        } else if (arg.rfind("--", 0) == 0 || !gridPath.empty()) {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            gridPath = arg;
+        }
+    }
+    if (gridPath.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // 步骤2：读取文件头，映射整个文件；帧记录从文件头之后开始
+    GridFileHeader header;
+    std::ifstream headerStream(gridPath, std::ios::binary);
+    if (!headerStream || !readGridHeader(headerStream, header)) {
+        std::cerr << "无法读取字符网格文件: " << gridPath << std::endl;
+        return 1;
+    }
+    const size_t firstFrame = static_cast<size_t>(headerStream.tellg());
+    headerStream.close();
+
+    std::vector<std::string> glyphs;
+    if (!splitCharset(header.charset, glyphs) || glyphs.size() > 256) {
+        std::cerr << "错误: 字符网格文件中的字符集无效" << std::endl;
+        return 1;
+    }
+    MappedFile file;
+    if (!file.open(gridPath)) {
+        std::cerr << "无法映射字符网格文件: " << gridPath << std::endl;
+        return 1;
+    }
+
+    const double fileFps = header.fpsMilli > 0 ? header.fpsMilli / 1000.0 : PlayerConstants::DEFAULT_FPS;
+    const double fps = fpsOverride >= 0.0 ? fpsOverride : fileFps;
+    const bool pixelMode = bench || !rawPath.empty();
+
+    // 终端模式用终端字体显示字符，字形图块只用于覆盖率补偿
+    GlyphTiles tiles;
+    if (!loadGlyphTiles(header, glyphs, tiles)) {
+        return 1;
+    }
+    const std::vector<int> gains = (header.modes & GridFormat::MODE_COVERAGE_COMPENSATION)
+                                       ? glyphGains(tiles, header.cellWidth) : std::vector<int>(256, 256);
+    PixelRenderer pixels;
+    if (pixelMode) {
+        pixels.init(header, tiles, gains);
+    }
+    FILE* rawOut = nullptr;
+    if (!rawPath.empty()) {
+        rawOut = rawPath == "-" ? stdout : std::fopen(rawPath.c_str(), "wb");
+        if (!rawOut) {
+            std::cerr << "无法创建输出文件: " << rawPath << std::endl;
+            return 1;
+        }
+        std::cerr << "原始像素: " << pixels.frameWidth() << "x" << pixels.frameHeight() << " "
+                  << (pixels.pixelChannels() == 1 ? "gray" : "bgr24") << ", " << fileFps << "fps" << std::endl;
+    }
+
+    std::signal(SIGINT, handleInterrupt);
+    std::signal(SIGTERM, handleInterrupt);
+
+    // 步骤3：逐帧解码并输出
+    using Clock = std::chrono::steady_clock;
+    const bool paced = !bench && rawPath.empty() && fps > 0.0;
+    const auto frameInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(paced ? 1.0 / fps : 0.0));
+    std::unique_ptr<TerminalRenderer> terminal;
+    if (!pixelMode) {
+        // 标准输出不是终端（重定向到文件）时按网格大小输出
+        int windowColumns = header.width * TerminalRenderer::cellSpan(header);
+        int windowRows = header.height;
+        struct winsize window;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &window) == 0 && window.ws_col > 0 && window.ws_row > 0) {
+            if ((window.ws_col < windowColumns || window.ws_row < windowRows) && !crop) {
+                std::cerr << "错误: 终端窗口 " << window.ws_col << "x" << window.ws_row << " 放不下 "
+                          << windowColumns << "x" << windowRows << " 的字符网格，请放大窗口或缩小终端字体，"
+                          << "或使用 --crop 只播放中间部分" << std::endl;
+                return PlayerConstants::EXIT_TERMINAL_TOO_SMALL;
+            }
+            windowColumns = std::min<int>(windowColumns, window.ws_col);
+            windowRows = std::min<int>(windowRows, window.ws_row);
+        }
+        terminal.reset(new TerminalRenderer(header, glyphs, gains, windowColumns, windowRows));
+    }
+
+    AsciiGrid grid;
+    long frames = 0;
+    long skipped = 0;
+    Clock::duration decodeTime(0);
+    Clock::duration renderTime(0);
+    const auto start = Clock::now();
+    size_t offset = firstFrame;
+    bool corrupt = false;
+
+    while (!stopRequested) {
+        if (offset >= file.length()) {
+            if (!loop || frames == 0) {
+                break;
+            }
+            offset = firstFrame;  // 第一帧是原始帧，可以直接从头解码
+        }
+        auto t0 = Clock::now();
+        size_t used = decodeGridFrame(file.bytes() + offset, file.length() - offset, header, grid);
+        if (used == 0) {
+            corrupt = true;
+            break;
+        }
+        offset += used;
+        auto t1 = Clock::now();
+        decodeTime += t1 - t0;
+
+        if (terminal) {
+            terminal->accumulate(grid);
+            const auto due = start + frameInterval * frames;
+            const auto now = Clock::now();
+            if (paced && now > due + frameInterval) {
+                skipped++;  // 落后超过一帧：跳过输出，变化留到下一次输出
+            } else {
+                if (paced) {
+                    std::this_thread::sleep_until(due);
+                }
+                terminal->present(grid);
+            }
+        } else {
+            pixels.render(grid);
+            renderTime += Clock::now() - t1;
+            if (rawOut && std::fwrite(pixels.frame().data(), 1, pixels.frame().size(), rawOut) != pixels.frame().size()) {
+                break;  // 管道另一端已关闭
+            }
+        }
+        frames++;
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    terminal.reset();
+    if (rawOut && rawOut != stdout) {
+        std::fclose(rawOut);
+    } else if (rawOut) {
+        std::fflush(rawOut);
+    }
+
+    if (corrupt) {
+        std::cerr << "错误: 第 " << frames << " 帧记录损坏或格式不支持" << std::endl;
+    }
+
+    // 步骤4：报告结果
+    if (bench) {
+        const double decodeSeconds = std::chrono::duration<double>(decodeTime).count();
+        const double renderSeconds = std::chrono::duration<double>(renderTime).count();
+        std::cout << "帧数: " << frames << "，网格 " << header.width << "x" << header.height
+                  << "，像素 " << pixels.frameWidth() << "x" << pixels.frameHeight() << std::endl;
+        if (frames > 0) {
+            std::cout << "平均每帧: " << (offset - firstFrame) / frames << " 字节" << std::endl;
+        }
+        std::cout << "解码: " << (decodeSeconds > 0 ? frames / decodeSeconds : 0.0) << " fps" << std::endl;
+        std::cout << "渲染: " << (renderSeconds > 0 ? frames / renderSeconds : 0.0) << " fps" << std::endl;
+        std::cout << "解码+渲染: " << (decodeSeconds + renderSeconds > 0 ? frames / (decodeSeconds + renderSeconds) : 0.0)
+                  << " fps" << std::endl;
+    } else if (!rawOut) {
+        std::cout << "播放 " << frames << " 帧，用时 " << elapsed << " 秒";
+        if (skipped > 0) {
+            std::cout << "，跳过输出 " << skipped << " 帧";
+        }
+        std::cout << std::endl;
+    }
+    return corrupt ? 1 : 0;
+}
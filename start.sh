@@ -71,7 +71,7 @@ install_dependencies() {
             PKG_MANAGER="apt-get"                              # 包管理器命令
             PKG_UPDATE="sudo $PKG_MANAGER update"              # 更新包列表命令
             PKG_INSTALL="sudo $PKG_MANAGER install -y"         # 安装包命令（-y自动确认）
-            PKGS="g++ build-essential libopencv-dev mpv"           # 需要安装的包列表
+            PKGS="g++ build-essential libopencv-dev zlib1g-dev mpv"           # 需要安装的包列表
             ;;
         fedora|centos|rhel|rocky)
             # RedHat系发行版（Fedora、CentOS、RHEL、Rocky Linux等）
@@ -82,19 +82,19 @@ install_dependencies() {
             fi
             PKG_UPDATE="sudo $PKG_MANAGER update -y"           # 更新包列表命令
             PKG_INSTALL="sudo $PKG_MANAGER install -y"         # 安装包命令
-            PKGS="gcc-c++ pkg-config opencv-devel mpv"        # 需要安装的包列表
+            PKGS="gcc-c++ pkg-config opencv-devel zlib-devel mpv"        # 需要安装的包列表
             ;;
         arch|manjaro)
             # Arch系发行版（Arch Linux、Manjaro等）
             PKG_MANAGER="pacman"                               # 包管理器命令
             PKG_UPDATE="sudo $PKG_MANAGER -Sy"                 # -S同步数据库，-y下载最新数据库
             PKG_INSTALL="sudo $PKG_MANAGER -S --noconfirm"     # --noconfirm自动确认安装
-            PKGS="gcc pkgconf opencv mpv"                  # 需要安装的包列表
+            PKGS="gcc pkgconf opencv zlib mpv"                  # 需要安装的包列表
             ;;
         *)
             # 不支持的发行版
             print_error "不支持的Linux发行版: $OS"
-            print_info "请手动安装以下依赖: g++, pkg-config, opencv, mpv"
+            print_info "请手动安装以下依赖: g++, pkg-config, opencv, zlib, mpv"
             exit 1
             ;;
     esac
@@ -205,8 +205,39 @@ main() {
     print_info "开始编译程序..."
 
     # 第五步：编译C++程序
+    # 检测可选的FreeType库：存在时启用 --font 字体渲染
+    EXTRA_FLAGS=""
+    EXTRA_PKGS=""
+    if pkg-config --exists freetype2; then
+        print_info "找到FreeType库，启用 --font 字体渲染"
+        EXTRA_FLAGS="-DMIKU_WITH_FREETYPE"
+        EXTRA_PKGS="freetype2"
+    else
+        print_warning "未找到FreeType库，--font 字体渲染不可用"
+    fi
+    # 检测可选的liburing库：存在时图像序列和字符网格文件经io_uring批量写出
+    if pkg-config --exists liburing; then
+        print_info "找到liburing库，启用io_uring异步写出"
+        EXTRA_FLAGS="$EXTRA_FLAGS -DMIKU_WITH_URING"
+        EXTRA_PKGS="$EXTRA_PKGS liburing"
+    fi
+    # 检测可选的libwebp库：存在时可输出动画WebP（.webp）
+    if pkg-config --exists libwebpmux; then
+        print_info "找到libwebp库，启用动画WebP输出"
+        EXTRA_FLAGS="$EXTRA_FLAGS -DMIKU_WITH_WEBP"
+        EXTRA_PKGS="$EXTRA_PKGS libwebpmux"
+    fi
+
+    # 检测编译器是否支持C++20：支持时启用 --job 的协程调度，否则退回C++17
+    CXX_STD="c++17"
+    if echo 'int main(){}' | g++ -std=c++20 -x c++ - -o /dev/null 2>/dev/null; then
+        CXX_STD="c++20"
+    else
+        print_warning "编译器不支持C++20，--job 并发任务将以每任务一个线程的方式运行"
+    fi
+
     # 显示编译命令给用户看
-    print_info "执行编译命令: g++ -O3 -march=native -std=c++17 -o miku miku.cpp \`pkg-config --cflags --libs opencv4\` -lpthread"
+    print_info "执行编译命令: g++ -O3 -march=native -std=$CXX_STD $EXTRA_FLAGS -o miku miku.cpp \`pkg-config --cflags --libs opencv4 $EXTRA_PKGS\` -lz -lpthread"
 
     # 根据OpenCV版本选择不同的编译命令
     if pkg-config --exists opencv4; then
@@ -214,15 +245,17 @@ main() {
         # 编译参数说明：
         # -O3：最高级别的编译优化，提高程序运行速度
         # -march=native：为当前CPU架构优化，利用所有可用的CPU特性
-        # -std=c++17：使用C++17标准编译
+        # -std=$CXX_STD：使用C++20标准编译（编译器不支持时为C++17）
         # -o miku：指定输出文件名为miku
         # `pkg-config --cflags --libs opencv4`：自动获取OpenCV的编译和链接参数
+        # -lz：链接zlib，字符网格文件的帧记录经deflate压缩
         # -lpthread：链接POSIX线程库，支持多线程
-        g++ -O3 -march=native -std=c++17 -o miku miku.cpp `pkg-config --cflags --libs opencv4` -lpthread
+        # $EXTRA_FLAGS / $EXTRA_PKGS：可选库（FreeType、liburing、libwebp）的宏定义和pkg-config包名
+        g++ -O3 -march=native -std=$CXX_STD $EXTRA_FLAGS -o miku miku.cpp `pkg-config --cflags --libs opencv4 $EXTRA_PKGS` -lz -lpthread
     else
         # 使用OpenCV 3.x或更早版本编译
         print_warning "未找到opencv4，尝试使用opencv"
-        g++ -O3 -march=native -std=c++17 -o miku miku.cpp `pkg-config --cflags --libs opencv` -lpthread
+        g++ -O3 -march=native -std=$CXX_STD $EXTRA_FLAGS -o miku miku.cpp `pkg-config --cflags --libs opencv $EXTRA_PKGS` -lz -lpthread
     fi
 
     # 第六步：检查编译是否成功
@@ -238,19 +271,29 @@ main() {
         exit 1
     fi
 
+    # 编译字符网格播放器：只依赖标准库、zlib和 miku_grid.h，不需要OpenCV
+    # 编译失败时仍可用mpv播放ascii.mp4
+    print_info "执行编译命令: g++ -O3 -march=native -std=c++17 -o miku_player miku_player.cpp -lz"
+    if g++ -O3 -march=native -std=c++17 -o miku_player miku_player.cpp -lz; then
+        print_success "编译成功！生成可执行文件: miku_player"
+    else
+        print_warning "字符网格播放器编译失败，将使用mpv播放ASCII视频"
+    fi
+
     echo "========================================"
     print_info "运行ASCII视频转换..."
 
     # 第七步：运行视频转换程序
     if [ -f "miku.mp4" ]; then
         # 显示转换命令
-        print_info "执行转换命令: ./miku miku.mp4 ascii.mp4 150 1.5"
+        print_info "执行转换命令: ./miku miku.mp4 ascii.mp4 150 1.5 --grid-out ascii.mgrid"
         # 执行转换命令，参数说明：
         # miku.mp4：输入视频文件
         # ascii.mp4：输出ASCII视频文件
         # 150：ASCII宽度（每行150个字符）
         # 1.5：质量参数
-        ./miku miku.mp4 ascii.mp4 150 1.5
+        # --grid-out ascii.mgrid：同时输出字符网格文件，供 miku_player 直接播放
+        ./miku miku.mp4 ascii.mp4 150 1.5 --grid-out ascii.mgrid
 
         # 检查转换是否成功
         if [ $? -eq 0 ] && [ -f "ascii.mp4" ]; then
@@ -270,12 +313,9 @@ main() {
 
     # 第八步：播放视频
     # 同时播放原始视频和ASCII视频，方便对比
-    print_info "执行播放命令: mpv miku.mp4 & mpv ascii.mp4"
-
-    # 启动mpv播放器播放两个视频
     # & 符号表示在后台运行命令
-    mpv miku.mp4 & mpv ascii.mp4
-    MPV1_PID=$!  # 获取第一个mpv进程的PID
+    mpv miku.mp4 &
+    MPV1_PID=$!  # 获取mpv进程的PID
 
     # 等待1秒，让播放器有时间启动
     sleep 1
@@ -283,11 +323,26 @@ main() {
     # 检查进程是否在运行
     # kill -0 命令用于检查进程是否存在，不发送任何信号
     if kill -0 $MPV1_PID 2>/dev/null; then
-        print_success "两个视频播放器已启动"
-        print_info "原始视频 PID: $MPV1_PID"
-        print_info "ASCII视频 PID: $MPV2_PID"
+        print_success "原始视频播放器已启动，PID: $MPV1_PID"
     else
-        print_warning "部分播放器可能启动失败"
+        print_warning "原始视频播放器可能启动失败"
+    fi
+
+    # ASCII视频优先用 miku_player 在当前终端中播放字符网格文件（按 Ctrl+C 退出），
+    # 不经过视频编解码；播放器或网格文件不可用时用mpv播放ascii.mp4
+    # 150列的网格需要至少150列的终端窗口：窗口放不下时播放器以退出码2退出，同样改用mpv
+    PLAYER_STATUS=1
+    if [ -x "miku_player" ] && [ -f "ascii.mgrid" ]; then
+        print_info "执行播放命令: ./miku_player ascii.mgrid"
+        ./miku_player ascii.mgrid
+        PLAYER_STATUS=$?
+        if [ $PLAYER_STATUS -eq 2 ]; then
+            print_warning "终端窗口放不下字符网格，改用mpv播放"
+        fi
+    fi
+    if [ $PLAYER_STATUS -eq 1 ] || [ $PLAYER_STATUS -eq 2 ]; then
+        print_info "执行播放命令: mpv ascii.mp4"
+        mpv ascii.mp4
     fi
 
     echo "========================================"
@@ -301,7 +356,7 @@ main "$@"
 # ========================================
 # 脚本使用说明：
 # 1. 确保脚本有执行权限：chmod +x start.sh
-# 2. 确保当前目录有miku.cpp和miku.mp4文件
+# 2. 确保当前目录有miku.cpp、miku_player.cpp和miku.mp4文件
 # 3. 运行脚本：./start.sh
 #
 # 脚本执行流程：
@@ -309,7 +364,8 @@ main "$@"
 # 2. 检查并安装必要依赖
 # 3. 编译C++程序
 # 4. 转换视频为ASCII艺术风格
-# 5. 同时播放原始视频和转换后的视频
+# 5. 用mpv播放原始视频，同时用miku_player在终端中播放字符网格文件
+#    （可用 ./miku_player ascii.mgrid --bench 测试解码和渲染帧率）
 #
 # 注意事项：
 # 1. 需要管理员权限安装依赖，脚本会提示输入密码